@@ -112,6 +112,13 @@ const ActionType & ActionsInProgress::getAction(const UnitCountType i) const
 	return _inProgress[i]._action;
 }
 	
+const ActionInProgress & ActionsInProgress::getActionInProgress(const UnitCountType i) const
+{
+    BOSS_ASSERT(i < _inProgress.size(), "index out of bounds");
+
+	return _inProgress[i];
+}
+
 FrameCountType ActionsInProgress::getTime(const UnitCountType i) const
 {
     BOSS_ASSERT(i < _inProgress.size(), "index out of bounds");
@@ -20,17 +20,40 @@ class ActionInProgress
 public:
 
 	ActionType 		_action;
+    signed char     _mineralWorkers;    // change in mineral workers when the action finishes
+    signed char     _gasWorkers;        // change in gas workers when the action finishes
 	FrameCountType 	_time;
 	
 	ActionInProgress() 
-        : _time(0) 
+        : _mineralWorkers(0)
+        , _gasWorkers(0)
+        , _time(0) 
     {  
     }
 	
+    // the worker changes are looked up once here so income predictions don't have to look at the
+    // action type of everything in progress. they fit in the padding before _time
     ActionInProgress(const ActionType & action, FrameCountType t) 
         : _action(action)
+        , _mineralWorkers(0)
+        , _gasWorkers(0)
         , _time(t) 
     {
+        // finishing a building as terran gives you a mineral worker back
+        if (action.isBuilding() && !action.isAddon() && (action.getRace() == Races::Terran))
+        {
+            _mineralWorkers++;
+        }
+
+        if (action.isWorker())
+        {
+            _mineralWorkers++;
+        }
+        else if (action.isRefinery())
+        {
+            _mineralWorkers -= 3;
+            _gasWorkers += 3;
+        }
     }
 	
 
@@ -68,6 +91,7 @@ public:
 	FrameCountType whenActionsFinished(const PrerequisiteSet & actions) const;
 	
 	const ActionType & getAction(const UnitCountType index) const;
+    const ActionInProgress & getActionInProgress(const UnitCountType index) const;
 	const ActionType & nextAction() const;
 	
 	void printActionsInProgress();
@@ -2,54 +2,155 @@
 
 using namespace BOSS;
 
+static_assert(Constants::MAX_ACTION_TYPES <= 128, "ActionSet bitset holds at most 128 action types");
+
 ActionSet::ActionSet()
+    : _race(Races::None)
 {
+    clear();
+}
 
+// portable popcount, the 32 bit windows builds have no 64 bit intrinsics
+size_t ActionSet::BitCount(unsigned long long bits)
+{
+    bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (size_t)((bits * 0x0101010101010101ULL) >> 56);
+}
+
+// index of the lowest set bit, bits must not be zero
+size_t ActionSet::LowestBit(unsigned long long bits)
+{
+    return BitCount((bits & (~bits + 1)) - 1);
 }
 
 const size_t ActionSet::size() const
 {
-    return _actionTypes.size();
+    return BitCount(_bits[0]) + BitCount(_bits[1]);
 }
 
 const bool ActionSet::isEmpty() const
 {
-    return size() == 0;
+    return (_bits[0] | _bits[1]) == 0;
 }
 
-const ActionType & ActionSet::operator [] (const size_t & index) const
+// the index-th action of the set in ID order, returned by value since sets are built while
+// ActionTypeData is initialized, before the ActionTypes table exists
+ActionType ActionSet::operator [] (const size_t & index) const
 {
-    return _actionTypes[index];
+    size_t remaining = index;
+
+    for (size_t w(0); w < NUM_WORDS; ++w)
+    {
+        const size_t count = BitCount(_bits[w]);
+
+        if (remaining < count)
+        {
+            unsigned long long bits = _bits[w];
+            for (size_t i(0); i < remaining; ++i)
+            {
+                bits &= bits - 1;
+            }
+
+            return ActionType(_race, (ActionID)(w*64 + LowestBit(bits)));
+        }
+
+        remaining -= count;
+    }
+
+    BOSS_ASSERT(false, "ActionSet index out of range: %d", (int)index);
+    return ActionType();
 }
 
-ActionType & ActionSet::operator [] (const size_t & index)
+const bool ActionSet::contains(const ActionType & action) const
 {
-    return _actionTypes[index];
+    const size_t id = action.ID();
+
+    return (action.getRace() == _race) && ((_bits[id >> 6] >> (id & 63)) & 1ULL);
 }
 
-const bool ActionSet::contains(const ActionType & action) const
+// true if every action of set is also in this set
+const bool ActionSet::contains(const ActionSet & set) const
 {
-    return _actionTypes.contains(action);
+    if (set.isEmpty())
+    {
+        return true;
+    }
+
+    if (set._race != _race)
+    {
+        return false;
+    }
+
+    return ((set._bits[0] & ~_bits[0]) | (set._bits[1] & ~_bits[1])) == 0;
 }
 
 void ActionSet::add(const ActionType & action)
 {
-    _actionTypes.push_back(action);
+    if (isEmpty())
+    {
+        _race = action.getRace();
+    }
+
+    BOSS_ASSERT(action.getRace() == _race, "Adding an action of another race to an ActionSet");
+
+    const size_t id = action.ID();
+    _bits[id >> 6] |= 1ULL << (id & 63);
+}
+
+void ActionSet::add(const ActionSet & set)
+{
+    if (set.isEmpty())
+    {
+        return;
+    }
+
+    if (isEmpty())
+    {
+        _race = set._race;
+    }
+
+    BOSS_ASSERT(set._race == _race, "Adding actions of another race to an ActionSet");
+
+    _bits[0] |= set._bits[0];
+    _bits[1] |= set._bits[1];
+}
+
+void ActionSet::addAllActions(const RaceID & race)
+{
+    const size_t numActions = ActionTypes::GetAllActionTypes(race).size();
+
+    for (size_t a(0); a < numActions; ++a)
+    {
+        add(ActionTypes::GetActionType(race, (ActionID)a));
+    }
 }
 
 void ActionSet::remove(const ActionType & action)
 {
-    for (size_t i(0); i<_actionTypes.size(); ++i)
+    if (action.getRace() != _race)
     {
-        if (_actionTypes[i] == action)
-        {
-            _actionTypes.removeByShift(i);
-            return;
-        }
+        return;
     }
+
+    const size_t id = action.ID();
+    _bits[id >> 6] &= ~(1ULL << (id & 63));
+}
+
+void ActionSet::remove(const ActionSet & set)
+{
+    if (set._race != _race)
+    {
+        return;
+    }
+
+    _bits[0] &= ~set._bits[0];
+    _bits[1] &= ~set._bits[1];
 }
 
 void ActionSet::clear()
 {
-    _actionTypes.clear();
-}
\ No newline at end of file
+    _bits[0] = 0;
+    _bits[1] = 0;
+}
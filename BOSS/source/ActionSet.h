@@ -8,9 +8,18 @@
 namespace BOSS
 {
 
+// set of action types of one race stored as a bitset indexed by action ID
+// membership tests and subset tests are a few word operations, iteration by index visits
+// the actions in ID order
 class ActionSet
 {
-	Vec<ActionType, Constants::MAX_ACTION_TYPES> _actionTypes;
+    static const size_t NUM_WORDS = 2;
+
+    unsigned long long  _bits[NUM_WORDS];
+    RaceID              _race;
+
+    static size_t       BitCount(unsigned long long bits);
+    static size_t       LowestBit(unsigned long long bits);
 
 public:
 
@@ -19,14 +28,16 @@ public:
     const size_t size() const;
     const bool isEmpty() const;
     const bool contains(const ActionType & type) const;
+    const bool contains(const ActionSet & set) const;
 
-    const ActionType & operator [] (const size_t & index) const;
-    ActionType & operator [] (const size_t & index);
+    ActionType operator [] (const size_t & index) const;
 
     void add(const ActionType & action);
+    void add(const ActionSet & set);
     void addAllActions(const RaceID & race);
     void remove(const ActionType & action);
+    void remove(const ActionSet & set);
     void clear();
 };
 
-}
\ No newline at end of file
+}
@@ -19,13 +19,6 @@ ActionType::ActionType(const RaceID & race, const ActionID & id)
 
 }
 
-ActionType::ActionType(const ActionType & type)
-: _race(type._race)
-, _id(type._id)
-{
-
-}
-
 ActionType::ActionType(const BWAPI::UnitType & type)
     : _race(ActionTypeData::GetRaceID(type.getRace()))
     , _id(ActionTypeData::GetActionID(type))
@@ -47,16 +40,6 @@ ActionType::ActionType(const BWAPI::TechType & type)
 
 }
 
-ActionType & ActionType::operator = (const ActionType & rhs)
-{
-    if (this != &rhs)
-    {
-        new (this) ActionType(rhs);
-    }
-
-    return *this;
-}   
-
 const ActionID              ActionType::ID()                    const { return _id; }
 const RaceID                ActionType::getRace()               const { return _race; }
 
@@ -9,20 +9,17 @@ class PrerequisiteSet;
 
 class ActionType
 {
-    const ActionID	    _id;
-    const RaceID        _race;
+    ActionID	        _id;
+    RaceID              _race;
 
 public:
 	
     ActionType();
     ActionType(const RaceID & race, const ActionID & id);
-    ActionType(const ActionType & type);
     ActionType(const BWAPI::UnitType & type);
     ActionType(const BWAPI::UpgradeType & type);
     ActionType(const BWAPI::TechType & type);
 
-    ActionType & operator = (const ActionType & rhs);
-
     const ActionID              ID()                    const;
     const RaceID                getRace()               const;
 
@@ -2,6 +2,9 @@
 
 #include "CombatSearchExperiment.h"
 #include "BOSSPlotBuildOrders.h"
+#include "DFBBBenchmark.h"
+#include "BuildOrderCacheWarmer.h"
+#include "BuildOrderBatchSimulationCheck.h"
 
 using namespace BOSS;
 
@@ -33,6 +36,18 @@ void Experiments::RunExperiments(const std::string & experimentFilename)
             {
                 RunBuildOrderPlot(name, val);
             }
+            else if (type == "DFBBBenchmark")
+            {
+                RunDFBBBenchmark(name, val);
+            }
+            else if (type == "BuildOrderCacheWarm")
+            {
+                RunBuildOrderCacheWarm(name, val);
+            }
+            else if (type == "BuildOrderBatchSimulation")
+            {
+                RunBuildOrderBatchSimulation(name, val);
+            }
             else
             {
                 BOSS_ASSERT(false, "Unknown Experiment Type: %s", type.c_str());
@@ -53,4 +68,22 @@ void Experiments::RunBuildOrderPlot(const std::string & name, const rapidjson::V
 {
     BOSSPlotBuildOrders plot(name, val);
     plot.doPlots();
+}
+
+void Experiments::RunDFBBBenchmark(const std::string & name, const rapidjson::Value & val)
+{
+    DFBBBenchmark benchmark(name, val);
+    benchmark.run();
+}
+
+void Experiments::RunBuildOrderCacheWarm(const std::string & name, const rapidjson::Value & val)
+{
+    BuildOrderCacheWarmer warmer(name, val);
+    warmer.run();
+}
+
+void Experiments::RunBuildOrderBatchSimulation(const std::string & name, const rapidjson::Value & val)
+{
+    BuildOrderBatchSimulationCheck check(name, val);
+    check.run();
 }
\ No newline at end of file
@@ -14,6 +14,9 @@ namespace Experiments
 
     void RunCombatExperiment(const std::string & name, const rapidjson::Value & val);
     void RunBuildOrderPlot(const std::string & name, const rapidjson::Value & val);
+    void RunDFBBBenchmark(const std::string & name, const rapidjson::Value & val);
+    void RunBuildOrderCacheWarm(const std::string & name, const rapidjson::Value & val);
+    void RunBuildOrderBatchSimulation(const std::string & name, const rapidjson::Value & val);
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "BuildOrderBatchSimulationCheck.h"
+#include "DFBBBenchmark.h"
+
+using namespace BOSS;
+
+BuildOrderBatchSimulationCheck::BuildOrderBatchSimulationCheck(const std::string & name, const rapidjson::Value & val)
+    : _name(name)
+    , _variants(2000)
+    , _threads(1)
+    , _seed(0)
+{
+    BOSS_ASSERT(val.HasMember("BuildOrderDir") && val["BuildOrderDir"].IsString(), "BuildOrderBatchSimulationCheck must have a 'BuildOrderDir' string");
+    _buildOrderDir = val["BuildOrderDir"].GetString();
+
+    BOSS_ASSERT(val.HasMember("BuildOrders") && val["BuildOrders"].IsArray(), "BuildOrderBatchSimulationCheck must have a 'BuildOrders' array");
+    for (size_t i(0); i < val["BuildOrders"].Size(); ++i)
+    {
+        BOSS_ASSERT(val["BuildOrders"][i].IsString(), "BuildOrders element is not a string");
+
+        _buildOrderFiles.push_back(val["BuildOrders"][i].GetString());
+    }
+
+    if (val.HasMember("Variants") && val["Variants"].IsInt())
+    {
+        _variants = val["Variants"].GetInt();
+        BOSS_ASSERT(_variants > 0, "BuildOrderBatchSimulationCheck 'Variants' must be positive");
+    }
+
+    if (val.HasMember("Threads") && val["Threads"].IsInt())
+    {
+        _threads = val["Threads"].GetInt();
+        BOSS_ASSERT(_threads > 0, "BuildOrderBatchSimulationCheck 'Threads' must be positive");
+    }
+
+    if (val.HasMember("Seed") && val["Seed"].IsInt())
+    {
+        _seed = (unsigned int)val["Seed"].GetInt();
+    }
+}
+
+// a few neighbouring actions past a random point in the second half swapped, and one in four cut short
+BuildOrder BuildOrderBatchSimulationCheck::getVariant(const BuildOrder & buildOrder) const
+{
+    BuildOrder variant(buildOrder);
+
+    if (variant.size() < 4)
+    {
+        return variant;
+    }
+
+    const size_t half = variant.size() / 2;
+    const size_t start = half + rand() % (variant.size() - half);
+
+    for (int s(0); s < 3; ++s)
+    {
+        const size_t i = start + rand() % (variant.size() - start);
+
+        if (i + 1 < variant.size())
+        {
+            std::swap(variant[i], variant[i + 1]);
+        }
+    }
+
+    if (rand() % 4 == 0)
+    {
+        const size_t length = half + rand() % (variant.size() - half);
+
+        while (variant.size() > length)
+        {
+            variant.pop_back();
+        }
+    }
+
+    return variant;
+}
+
+// the same results BuildOrderBatchSimulator gives, by doing the actions one at a time
+BuildOrderSimulation BuildOrderBatchSimulationCheck::simulateOnItsOwn(const GameState & initialState, const BuildOrder & buildOrder) const
+{
+    BuildOrderSimulation simulation;
+
+    GameState state(initialState);
+    for (size_t a(0); a < buildOrder.size(); ++a)
+    {
+        if (!state.isLegal(buildOrder[a]))
+        {
+            return simulation;
+        }
+
+        state.doAction(buildOrder[a]);
+
+        simulation.startFrames.push_back(state.getCurrentFrame());
+        simulation.minerals.push_back(state.getMinerals());
+        simulation.gas.push_back(state.getGas());
+    }
+
+    GameState finalState(initialState);
+    simulation.legal = buildOrder.doActions(finalState);
+    simulation.finishFrame = finalState.getLastActionFinishTime();
+
+    BOSS_ASSERT(simulation.legal && simulation.finishFrame == state.getLastActionFinishTime(), "doActions doesn't agree with doing the actions one at a time");
+
+    return simulation;
+}
+
+void BuildOrderBatchSimulationCheck::checkResult(const BuildOrderSimulation & expected, const BuildOrderSimulation & result, const std::string & buildOrderFile, const size_t variant) const
+{
+    BOSS_ASSERT(result.legal == expected.legal, "%s variant %d: batch legal %d, on its own %d", buildOrderFile.c_str(), (int)variant, (int)result.legal, (int)expected.legal);
+
+    if (!expected.legal)
+    {
+        return;
+    }
+
+    BOSS_ASSERT(result.finishFrame == expected.finishFrame, "%s variant %d: batch finish frame %d, on its own %d", buildOrderFile.c_str(), (int)variant, (int)result.finishFrame, (int)expected.finishFrame);
+    BOSS_ASSERT(result.startFrames.size() == expected.startFrames.size(), "%s variant %d: batch has %d actions, on its own %d", buildOrderFile.c_str(), (int)variant, (int)result.startFrames.size(), (int)expected.startFrames.size());
+
+    for (size_t a(0); a < expected.startFrames.size(); ++a)
+    {
+        BOSS_ASSERT(result.startFrames[a] == expected.startFrames[a], "%s variant %d action %d: batch start frame %d, on its own %d", buildOrderFile.c_str(), (int)variant, (int)a, (int)result.startFrames[a], (int)expected.startFrames[a]);
+        BOSS_ASSERT(result.minerals[a] == expected.minerals[a], "%s variant %d action %d: batch minerals %d, on its own %d", buildOrderFile.c_str(), (int)variant, (int)a, (int)result.minerals[a], (int)expected.minerals[a]);
+        BOSS_ASSERT(result.gas[a] == expected.gas[a], "%s variant %d action %d: batch gas %d, on its own %d", buildOrderFile.c_str(), (int)variant, (int)a, (int)result.gas[a], (int)expected.gas[a]);
+    }
+}
+
+void BuildOrderBatchSimulationCheck::run()
+{
+    srand(_seed);
+
+    std::stringstream ss;
+    char line[256];
+
+    sprintf(line, "%-32s%10s%10s%12s%12s%14s%12s\n", "Build Order", "Variants", "Illegal", "Actions", "Simulated", "Single (ms)", "Batch (ms)");
+    ss << line;
+
+    for (size_t i(0); i < _buildOrderFiles.size(); ++i)
+    {
+        RaceID race = Races::None;
+        BuildOrder buildOrder;
+        DFBBBenchmark::ReadBuildOrderFile(_buildOrderDir + _buildOrderFiles[i], race, buildOrder);
+
+        GameState initialState(race);
+        initialState.setStartingState();
+
+        std::vector<BuildOrder> variants;
+        size_t numActions = 0;
+        for (int v(0); v < _variants; ++v)
+        {
+            variants.push_back(getVariant(buildOrder));
+            numActions += variants.back().size();
+        }
+
+        Timer timer;
+        timer.start();
+
+        std::vector<BuildOrderSimulation> expected;
+        for (size_t v(0); v < variants.size(); ++v)
+        {
+            expected.push_back(simulateOnItsOwn(initialState, variants[v]));
+        }
+
+        const double singleMS = timer.getElapsedTimeInMilliSec();
+        timer.start();
+
+        BuildOrderBatchSimulator simulator(initialState);
+        for (size_t v(0); v < variants.size(); ++v)
+        {
+            simulator.add(variants[v]);
+        }
+
+        simulator.simulate(_threads);
+
+        const double batchMS = timer.getElapsedTimeInMilliSec();
+
+        int illegal = 0;
+        for (size_t v(0); v < variants.size(); ++v)
+        {
+            checkResult(expected[v], simulator.getResult(v), _buildOrderFiles[i], v);
+            illegal += expected[v].legal ? 0 : 1;
+        }
+
+        sprintf(line, "%-32s%10d%10d%12d%12d%14.1lf%12.1lf\n", _buildOrderFiles[i].c_str(), (int)variants.size(), illegal, (int)numActions, 
+            (int)simulator.getNumSimulatedActions(), singleMS, batchMS);
+        ss << line;
+    }
+
+    std::cout << "\n" << _name << "\n\n" << ss.str() << "\nEvery batch result matched\n" << std::endl;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "BOSS.h"
+#include "BuildOrderBatchSimulator.h"
+#include "JSONTools.h"
+#include "rapidjson/rapidjson.h"
+#include "rapidjson/document.h"
+
+namespace BOSS
+{
+
+// checks BuildOrderBatchSimulator against simulating each build order on its own
+// every build order file (same format as DFBBBenchmark's) gives 'Variants' build orders made by swapping
+// neighbouring actions in its second half and cutting some short, so the batch trie shares long prefixes
+// and some variants are illegal. the whole set is simulated as one batch with 'Threads' threads and every
+// result has to match doing the build order's actions one at a time from the start state: legality, the
+// finish frame, and the start frame, minerals and gas after each action. any difference is an assert
+class BuildOrderBatchSimulationCheck
+{
+    std::string                 _name;
+    std::string                 _buildOrderDir;
+    std::vector<std::string>    _buildOrderFiles;
+    int                         _variants;
+    int                         _threads;
+    unsigned int                _seed;
+
+    BuildOrder                  getVariant(const BuildOrder & buildOrder) const;
+    BuildOrderSimulation        simulateOnItsOwn(const GameState & initialState, const BuildOrder & buildOrder) const;
+    void                        checkResult(const BuildOrderSimulation & expected, const BuildOrderSimulation & result, const std::string & buildOrderFile, const size_t variant) const;
+
+public:
+
+    BuildOrderBatchSimulationCheck(const std::string & name, const rapidjson::Value & experimentVal);
+
+    void run();
+};
+}
@@ -0,0 +1,262 @@
+#include "BuildOrderBatchSimulator.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <exception>
+
+using namespace BOSS;
+
+BuildOrderSimulation::BuildOrderSimulation()
+    : legal(false)
+    , finishFrame(0)
+{
+
+}
+
+BuildOrderBatchSimulator::Node::Node(const ActionType & a, const size_t p)
+    : action(a)
+    , parent(p)
+    , legal(false)
+    , startFrame(0)
+    , finishFrame(0)
+    , minerals(0)
+    , gas(0)
+{
+
+}
+
+// node 0 is the root of the trie, it stands for the initial state and has no action
+BuildOrderBatchSimulator::BuildOrderBatchSimulator(const GameState & initialState)
+    : _initialState(initialState)
+{
+    _nodes.push_back(Node(ActionType(), 0));
+}
+
+size_t BuildOrderBatchSimulator::add(const BuildOrder & buildOrder)
+{
+    BOSS_ASSERT(buildOrder.empty() || buildOrder[0].getRace() == _initialState.getRace(), "Build order race doesn't match the initial state");
+
+    size_t node = 0;
+
+    for (size_t i(0); i < buildOrder.size(); ++i)
+    {
+        size_t child = 0;
+
+        for (size_t c(0); c < _nodes[node].children.size(); ++c)
+        {
+            if (_nodes[_nodes[node].children[c]].action == buildOrder[i])
+            {
+                child = _nodes[node].children[c];
+                break;
+            }
+        }
+
+        if (child == 0)
+        {
+            child = _nodes.size();
+            _nodes.push_back(Node(buildOrder[i], node));
+            _nodes[node].children.push_back(child);
+        }
+
+        node = child;
+    }
+
+    _buildOrderNodes.push_back(node);
+    return _buildOrderNodes.size() - 1;
+}
+
+void BuildOrderBatchSimulator::simulate(const int numThreads)
+{
+    BOSS_ASSERT(numThreads > 0, "Batch simulation needs at least one thread");
+
+    // nodes under an illegal action are never reached, they must not keep a previous simulation's values
+    for (size_t n(0); n < _nodes.size(); ++n)
+    {
+        _nodes[n].legal = false;
+    }
+
+    Node & root = _nodes[0];
+    root.legal = true;
+    root.startFrame = _initialState.getCurrentFrame();
+    root.finishFrame = _initialState.getLastActionFinishTime();
+    root.minerals = _initialState.getMinerals();
+    root.gas = _initialState.getGas();
+
+    // spread the trie out breadth first until there are enough subtrees to keep the threads busy
+    std::vector<size_t> subtrees(1, 0);
+    std::vector<GameState> subtreeStates(1, _initialState);
+
+    while ((numThreads > 1) && (subtrees.size() < (size_t)numThreads * SubtreesPerThread))
+    {
+        std::vector<size_t> nextSubtrees;
+        std::vector<GameState> nextSubtreeStates;
+
+        for (size_t s(0); s < subtrees.size(); ++s)
+        {
+            const std::vector<size_t> & children = _nodes[subtrees[s]].children;
+
+            for (size_t c(0); c < children.size(); ++c)
+            {
+                nextSubtreeStates.push_back(GameState());
+                simulateNode(children[c], subtreeStates[s], nextSubtreeStates.back());
+
+                if (_nodes[children[c]].legal && !_nodes[children[c]].children.empty())
+                {
+                    nextSubtrees.push_back(children[c]);
+                }
+                else
+                {
+                    nextSubtreeStates.pop_back();
+                }
+            }
+        }
+
+        // every build order has ended
+        if (nextSubtrees.empty())
+        {
+            subtrees.clear();
+            break;
+        }
+
+        subtrees.swap(nextSubtrees);
+        subtreeStates.swap(nextSubtreeStates);
+    }
+
+    std::atomic<size_t> nextSubtree(0);
+    std::vector<std::exception_ptr> threadExceptions(numThreads);
+    std::vector<std::thread> threads;
+
+    for (int t(1); t < numThreads; ++t)
+    {
+        threads.push_back(std::thread([this, &subtrees, &subtreeStates, &nextSubtree, &threadExceptions, t]()
+        {
+            try
+            {
+                for (size_t s = nextSubtree++; s < subtrees.size(); s = nextSubtree++)
+                {
+                    simulateSubtree(subtrees[s], subtreeStates[s]);
+                }
+            }
+            catch (...)
+            {
+                threadExceptions[t] = std::current_exception();
+            }
+        }));
+    }
+
+    // the calling thread works on the subtrees too
+    try
+    {
+        for (size_t s = nextSubtree++; s < subtrees.size(); s = nextSubtree++)
+        {
+            simulateSubtree(subtrees[s], subtreeStates[s]);
+        }
+    }
+    catch (...)
+    {
+        threadExceptions[0] = std::current_exception();
+    }
+
+    for (size_t t(0); t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+
+    for (size_t t(0); t < threadExceptions.size(); ++t)
+    {
+        if (threadExceptions[t])
+        {
+            std::rethrow_exception(threadExceptions[t]);
+        }
+    }
+
+    collectResults();
+}
+
+// does the node's action from its parent's state, nodes under an illegal action are never simulated
+void BuildOrderBatchSimulator::simulateNode(const size_t node, const GameState & parentState, GameState & state)
+{
+    Node & n = _nodes[node];
+    n.legal = parentState.isLegal(n.action);
+
+    if (!n.legal)
+    {
+        return;
+    }
+
+    state = parentState;
+    state.doAction(n.action);
+
+    n.startFrame = state.getCurrentFrame();
+    n.finishFrame = state.getLastActionFinishTime();
+    n.minerals = state.getMinerals();
+    n.gas = state.getGas();
+}
+
+// simulates everything below a node whose own action is already done, state is the state after it
+void BuildOrderBatchSimulator::simulateSubtree(const size_t node, const GameState & state)
+{
+    GameState childState;
+
+    for (size_t c(0); c < _nodes[node].children.size(); ++c)
+    {
+        const size_t child = _nodes[node].children[c];
+
+        simulateNode(child, state, childState);
+
+        if (_nodes[child].legal)
+        {
+            simulateSubtree(child, childState);
+        }
+    }
+}
+
+void BuildOrderBatchSimulator::collectResults()
+{
+    _results.assign(_buildOrderNodes.size(), BuildOrderSimulation());
+
+    for (size_t b(0); b < _buildOrderNodes.size(); ++b)
+    {
+        BuildOrderSimulation & result = _results[b];
+        const Node & end = _nodes[_buildOrderNodes[b]];
+
+        if (!end.legal)
+        {
+            continue;
+        }
+
+        result.legal = true;
+        result.finishFrame = end.finishFrame;
+
+        // walk up to the root, the path comes out last action first
+        for (size_t node = _buildOrderNodes[b]; node != 0; node = _nodes[node].parent)
+        {
+            result.startFrames.push_back(_nodes[node].startFrame);
+            result.minerals.push_back(_nodes[node].minerals);
+            result.gas.push_back(_nodes[node].gas);
+        }
+
+        std::reverse(result.startFrames.begin(), result.startFrames.end());
+        std::reverse(result.minerals.begin(), result.minerals.end());
+        std::reverse(result.gas.begin(), result.gas.end());
+    }
+}
+
+size_t BuildOrderBatchSimulator::size() const
+{
+    return _buildOrderNodes.size();
+}
+
+// the number of actions the batch simulation does, one per trie node below the root, the simulations of
+// the build orders one at a time would instead do as many as the total length of all build orders
+size_t BuildOrderBatchSimulator::getNumSimulatedActions() const
+{
+    return _nodes.size() - 1;
+}
+
+const BuildOrderSimulation & BuildOrderBatchSimulator::getResult(const size_t index) const
+{
+    BOSS_ASSERT(index < _results.size(), "No simulation result for build order %d, was simulate called?", (int)index);
+
+    return _results[index];
+}
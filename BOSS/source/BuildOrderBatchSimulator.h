@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Common.h"
+#include "GameState.h"
+#include "BuildOrder.h"
+
+namespace BOSS
+{
+
+// what simulating one build order of a batch gave
+class BuildOrderSimulation
+{
+public:
+
+    bool                                legal;          // false if some action couldn't be done, the rest is then unset
+    FrameCountType                      finishFrame;    // frame the last action of the build order finishes
+
+    // per action of the build order, the frame it was started and the resources left right after
+    std::vector<FrameCountType>         startFrames;
+    std::vector<ResourceCountType>      minerals;
+    std::vector<ResourceCountType>      gas;
+
+    BuildOrderSimulation();
+};
+
+// simulates many build orders from the same state at once
+// the build orders are put in a prefix trie and every node of the trie is simulated once, so actions
+// shared by the start of many build orders are only done once. with more than one thread the trie is
+// simulated breadth first on the calling thread until it has spread into enough subtrees, which the
+// threads then take one at a time
+class BuildOrderBatchSimulator
+{
+    static const size_t                 SubtreesPerThread = 8;
+
+    class Node
+    {
+    public:
+
+        ActionType                      action;
+        size_t                          parent;
+        std::vector<size_t>             children;
+
+        bool                            legal;
+        FrameCountType                  startFrame;
+        FrameCountType                  finishFrame;
+        ResourceCountType               minerals;
+        ResourceCountType               gas;
+
+        Node(const ActionType & a, const size_t p);
+    };
+
+    GameState                           _initialState;
+    std::vector<Node>                   _nodes;
+    std::vector<size_t>                 _buildOrderNodes;   // trie node each build order ends at
+    std::vector<BuildOrderSimulation>   _results;
+
+    void                                simulateNode(const size_t node, const GameState & parentState, GameState & state);
+    void                                simulateSubtree(const size_t node, const GameState & state);
+    void                                collectResults();
+
+public:
+
+    BuildOrderBatchSimulator(const GameState & initialState);
+
+    // adds a build order to the batch and returns its index
+    size_t                              add(const BuildOrder & buildOrder);
+    void                                simulate(const int numThreads = 1);
+
+    size_t                              size() const;
+    size_t                              getNumSimulatedActions() const;
+    const BuildOrderSimulation &        getResult(const size_t index) const;
+};
+
+}
@@ -0,0 +1,404 @@
+#include "BuildOrderCache.h"
+#include <fstream>
+
+#ifdef WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+using namespace BOSS;
+
+BuildOrderCache::BuildOrderCache()
+    : _writable(false)
+    , _numEntries(0)
+    , _fileSize(0)
+    , _data(NULL)
+#ifdef WIN32
+    , _file(INVALID_HANDLE_VALUE)
+    , _mapping(NULL)
+#else
+    , _file(-1)
+#endif
+{
+
+}
+
+BuildOrderCache::~BuildOrderCache()
+{
+    close();
+}
+
+bool BuildOrderCache::open(const std::string & filename, const bool writable, const size_t numEntries)
+{
+    BOSS_ASSERT(numEntries > 0, "Build order cache must hold at least one entry");
+
+    close();
+
+    _filename = filename;
+    _writable = writable;
+
+    const size_t fileSize = sizeof(Header) + numEntries * sizeof(BuildOrderCacheEntry);
+
+    // map whatever is there first and see if it is a cache this version can read
+    if (mapFile(0, false))
+    {
+        const Header & header = *(const Header *)_data;
+
+        if (header.magic == Magic && header.version == Version && header.entrySize == sizeof(BuildOrderCacheEntry) &&
+            _fileSize == sizeof(Header) + header.numEntries * sizeof(BuildOrderCacheEntry))
+        {
+            _numEntries = header.numEntries;
+            return true;
+        }
+
+        unmapFile();
+    }
+
+    if (!writable || !mapFile(fileSize, true))
+    {
+        return false;
+    }
+
+    Header & header = *(Header *)_data;
+    header.magic = Magic;
+    header.version = Version;
+    header.numEntries = (unsigned int)numEntries;
+    header.entrySize = sizeof(BuildOrderCacheEntry);
+
+    _numEntries = numEntries;
+    memset(getEntries(), 0, numEntries * sizeof(BuildOrderCacheEntry));
+
+    return true;
+}
+
+bool BuildOrderCache::openCopy(const std::string & readFilename, const std::string & writeFilename, const size_t numEntries)
+{
+    if (writeFilename.empty())
+    {
+        return !readFilename.empty() && open(readFilename, false, numEntries);
+    }
+
+    const bool writeValid = open(writeFilename, false, numEntries);
+    close();
+
+    if (!writeValid && !readFilename.empty() && open(readFilename, false, numEntries))
+    {
+        close();
+
+        std::ifstream readFile(readFilename.c_str(), std::ios::in | std::ios::binary);
+        std::ofstream writeFile(writeFilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        writeFile << readFile.rdbuf();
+    }
+
+    return open(writeFilename, true, numEntries);
+}
+
+void BuildOrderCache::close()
+{
+    unmapFile();
+    _numEntries = 0;
+}
+
+// maps the whole file, or with create set makes it fileSize bytes long first
+bool BuildOrderCache::mapFile(const size_t fileSize, const bool create)
+{
+#ifdef WIN32
+    _file = CreateFileA(_filename.c_str(), _writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, NULL,
+        create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (_file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    size.QuadPart = (LONGLONG)fileSize;
+
+    if (!create && !GetFileSizeEx(_file, &size))
+    {
+        unmapFile();
+        return false;
+    }
+
+    _fileSize = (size_t)size.QuadPart;
+
+    if (_fileSize < sizeof(Header))
+    {
+        unmapFile();
+        return false;
+    }
+
+    // a mapping larger than the file grows the file to its size
+    _mapping = CreateFileMappingA(_file, NULL, _writable ? PAGE_READWRITE : PAGE_READONLY, size.HighPart, size.LowPart, NULL);
+
+    if (_mapping == NULL)
+    {
+        unmapFile();
+        return false;
+    }
+
+    _data = (char *)MapViewOfFile(_mapping, _writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, _fileSize);
+#else
+    _file = ::open(_filename.c_str(), _writable ? (O_RDWR | O_CREAT | (create ? O_TRUNC : 0)) : O_RDONLY, 0644);
+
+    if (_file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+
+    if (create ? (ftruncate(_file, (off_t)fileSize) != 0) : (fstat(_file, &fileStat) != 0))
+    {
+        unmapFile();
+        return false;
+    }
+
+    _fileSize = create ? fileSize : (size_t)fileStat.st_size;
+
+    if (_fileSize < sizeof(Header))
+    {
+        unmapFile();
+        return false;
+    }
+
+    void * data = mmap(NULL, _fileSize, _writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, _file, 0);
+    _data = (data == MAP_FAILED) ? NULL : (char *)data;
+#endif
+
+    if (_data == NULL)
+    {
+        unmapFile();
+        return false;
+    }
+
+    return true;
+}
+
+void BuildOrderCache::unmapFile()
+{
+#ifdef WIN32
+    if (_data != NULL)
+    {
+        UnmapViewOfFile(_data);
+    }
+
+    if (_mapping != NULL)
+    {
+        CloseHandle(_mapping);
+    }
+
+    if (_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_file);
+    }
+
+    _mapping = NULL;
+    _file = INVALID_HANDLE_VALUE;
+#else
+    if (_data != NULL)
+    {
+        munmap(_data, _fileSize);
+    }
+
+    if (_file >= 0)
+    {
+        ::close(_file);
+    }
+
+    _file = -1;
+#endif
+
+    _data = NULL;
+    _fileSize = 0;
+}
+
+bool BuildOrderCache::isOpen() const
+{
+    return _data != NULL;
+}
+
+size_t BuildOrderCache::getNumEntries() const
+{
+    return _numEntries;
+}
+
+size_t BuildOrderCache::getNumUsedEntries() const
+{
+    size_t used = 0;
+
+    for (size_t i(0); i < _numEntries; ++i)
+    {
+        if (getEntries()[i].key != 0)
+        {
+            ++used;
+        }
+    }
+
+    return used;
+}
+
+BuildOrderCacheEntry * BuildOrderCache::getEntries() const
+{
+    return (BuildOrderCacheEntry *)(_data + sizeof(Header));
+}
+
+void BuildOrderCache::MixKey(unsigned long long & key, const unsigned long long value, const unsigned long long prime)
+{
+    key = (key ^ value) * prime;
+}
+
+// two hashes over the same values with different multipliers, key picks the slot and both have to match
+void BuildOrderCache::GetKeys(const GameState & state, const BuildOrderSearchGoal & goal, unsigned long long & key, unsigned long long & check)
+{
+    const UnitData & units = state.getUnitData();
+    const size_t numActions = ActionTypes::GetAllActionTypes(state.getRace()).size();
+
+    std::vector<unsigned long long> values;
+
+    values.push_back(state.getRace());
+    values.push_back(units.getNumMineralWorkers());
+    values.push_back(units.getNumGasWorkers());
+    values.push_back(units.getNumBuildingWorkers());
+    values.push_back(units.getHatcheryData().numLarva());
+    values.push_back(state.getMinerals() / ResourceQuantum);
+    values.push_back(state.getGas() / ResourceQuantum);
+
+    for (size_t a(0); a < numActions; ++a)
+    {
+        const ActionType & action = ActionTypes::GetActionType(state.getRace(), (ActionID)a);
+
+        values.push_back((unsigned long long)units.getNumCompleted(action) << 16 | units.getNumInProgress(action));
+        values.push_back((unsigned long long)goal.getGoal(action) << 16 | goal.getGoalMax(action));
+    }
+
+    // time left on the actions in progress, in action ID order so equal states list them the same way
+    std::vector<unsigned long long> inProgress;
+    for (UnitCountType i(0); i < units.getNumActionsInProgress(); ++i)
+    {
+        const FrameCountType timeLeft = units.getActionInProgressFinishTimeByIndex(i) - state.getCurrentFrame();
+
+        inProgress.push_back((unsigned long long)units.getActionInProgressByIndex(i).ID() << 32 | (timeLeft / FrameQuantum));
+    }
+
+    std::sort(inProgress.begin(), inProgress.end());
+    values.insert(values.end(), inProgress.begin(), inProgress.end());
+
+    key = 14695981039346656037ULL;
+    check = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t i(0); i < values.size(); ++i)
+    {
+        MixKey(key, values[i], 1099511628211ULL);
+        MixKey(check, values[i], 0xFF51AFD7ED558CCDULL);
+    }
+
+    // zero marks an unused entry
+    key = key ? key : 1;
+}
+
+bool BuildOrderCache::lookup(const GameState & state, const BuildOrderSearchGoal & goal, BuildOrder & buildOrder) const
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    unsigned long long key = 0, check = 0;
+    GetKeys(state, goal, key, check);
+
+    const BuildOrderCacheEntry * entries = getEntries();
+
+    for (size_t p(0); p < ProbeLength; ++p)
+    {
+        const BuildOrderCacheEntry & entry = entries[(key + p) % _numEntries];
+
+        if (entry.key == 0)
+        {
+            return false;
+        }
+
+        if (entry.key != key || entry.check != check || entry.race != state.getRace() || entry.length > BuildOrderCacheEntry::MaxLength)
+        {
+            continue;
+        }
+
+        // the entry may have been stored from a state that was only nearly this one
+        BuildOrder cached;
+        GameState currentState(state);
+        for (size_t i(0); i < entry.length; ++i)
+        {
+            if (entry.actions[i] >= ActionTypes::GetAllActionTypes(state.getRace()).size())
+            {
+                return false;
+            }
+
+            const ActionType & action = ActionTypes::GetActionType(state.getRace(), entry.actions[i]);
+
+            if (!currentState.isLegal(action))
+            {
+                return false;
+            }
+
+            currentState.doAction(action);
+            cached.add(action);
+        }
+
+        BuildOrderSearchGoal goalCopy(goal);
+        if (!goalCopy.isAchievedBy(currentState))
+        {
+            return false;
+        }
+
+        buildOrder = cached;
+        return true;
+    }
+
+    return false;
+}
+
+void BuildOrderCache::store(const GameState & state, const BuildOrderSearchGoal & goal, const BuildOrder & buildOrder)
+{
+    BOSS_ASSERT(!isOpen() || _writable, "Storing into a read only build order cache");
+
+    if (!isOpen() || buildOrder.size() > BuildOrderCacheEntry::MaxLength)
+    {
+        return;
+    }
+
+    unsigned long long key = 0, check = 0;
+    GetKeys(state, goal, key, check);
+
+    BuildOrderCacheEntry * entries = getEntries();
+
+    // take the entry already holding this key, else the first free one, else overwrite the first probed
+    BuildOrderCacheEntry * entry = &entries[key % _numEntries];
+    for (size_t p(0); p < ProbeLength; ++p)
+    {
+        BuildOrderCacheEntry & probed = entries[(key + p) % _numEntries];
+
+        if (probed.key == 0 || (probed.key == key && probed.check == check))
+        {
+            entry = &probed;
+            break;
+        }
+    }
+
+    // the key goes in last so a lookup never sees a key with half written actions
+    entry->key = 0;
+    entry->check = check;
+    entry->length = (unsigned short)buildOrder.size();
+    entry->race = state.getRace();
+    entry->unused = 0;
+
+    for (size_t i(0); i < buildOrder.size(); ++i)
+    {
+        entry->actions[i] = buildOrder[i].ID();
+    }
+
+    entry->key = key;
+}
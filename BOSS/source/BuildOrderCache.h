@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Common.h"
+#include "GameState.h"
+#include "BuildOrder.h"
+#include "BuildOrderSearchGoal.h"
+
+namespace BOSS
+{
+
+// a solved search, stored in the cache file exactly as laid out here
+class BuildOrderCacheEntry
+{
+public:
+
+    static const size_t     MaxLength = 124;
+
+    unsigned long long      key;                    // hash of state and goal, 0 if unused
+    unsigned long long      check;                  // second hash of state and goal, tells apart keys that collide
+    unsigned short          length;
+    RaceID                  race;
+    unsigned char           unused;
+    ActionID                actions[MaxLength];
+};
+
+// build orders found by earlier searches, kept in a memory mapped file so they survive from game to game
+// the file is an open addressed table of fixed size entries behind a small header, a lookup reads the
+// mapping directly and a store writes the entry in place, the operating system writes it back to disk
+// states are keyed by what the search depends on: completed and in progress unit counts, worker split and
+// larva exactly, resources and the time left on actions in progress rounded to ResourceQuantum and
+// FrameQuantum, so states that are nearly the same share an entry. a stored build order is only handed
+// out if it is legal from the state asked about and reaches the goal from it
+class BuildOrderCache
+{
+    static const unsigned int       Magic = 0x43534F42;     // "BOSC"
+    static const unsigned int       Version = 1;
+    static const size_t             ProbeLength = 8;
+    static const ResourceCountType  ResourceQuantum = 25;
+    static const FrameCountType     FrameQuantum = 24;
+
+    struct Header
+    {
+        unsigned int                magic;
+        unsigned int                version;
+        unsigned int                numEntries;
+        unsigned int                entrySize;
+    };
+
+    std::string                     _filename;
+    bool                            _writable;
+    size_t                          _numEntries;
+    size_t                          _fileSize;
+    char *                          _data;
+
+#ifdef WIN32
+    void *                          _file;
+    void *                          _mapping;
+#else
+    int                             _file;
+#endif
+
+    BuildOrderCacheEntry *          getEntries() const;
+    bool                            mapFile(const size_t fileSize, const bool create);
+    void                            unmapFile();
+
+    static void                     MixKey(unsigned long long & key, const unsigned long long value, const unsigned long long prime);
+    static void                     GetKeys(const GameState & state, const BuildOrderSearchGoal & goal, unsigned long long & key, unsigned long long & check);
+
+    BuildOrderCache(const BuildOrderCache & other);
+    BuildOrderCache & operator = (const BuildOrderCache & other);
+
+public:
+
+    static const size_t             DefaultNumEntries = 1 << 16;
+
+    BuildOrderCache();
+    ~BuildOrderCache();
+
+    // maps the cache file, returns false if it can't be used. a writable cache creates the file, or
+    // starts it over if it was made by another version, a read only cache needs a valid file to exist
+    bool                            open(const std::string & filename, const bool writable, const size_t numEntries = DefaultNumEntries);
+
+    // opens a cache that is read from one file and written to another, for setups where the directory files
+    // are read from can't be written to. the read file is copied to the write file first, unless the write
+    // file already holds a valid cache. without a write file the read file is opened read only
+    bool                            openCopy(const std::string & readFilename, const std::string & writeFilename, const size_t numEntries = DefaultNumEntries);
+    void                            close();
+
+    bool                            isOpen() const;
+    size_t                          getNumEntries() const;
+    size_t                          getNumUsedEntries() const;
+
+    // true if a build order for this state and goal was stored, it is then written to buildOrder
+    bool                            lookup(const GameState & state, const BuildOrderSearchGoal & goal, BuildOrder & buildOrder) const;
+
+    // stores a build order for this state and goal, build orders too long for an entry are not stored
+    void                            store(const GameState & state, const BuildOrderSearchGoal & goal, const BuildOrder & buildOrder);
+};
+}
@@ -0,0 +1,141 @@
+#include "BuildOrderCacheWarmer.h"
+#include "BuildOrderTester.h"
+
+using namespace BOSS;
+
+BuildOrderCacheWarmer::BuildOrderCacheWarmer(const std::string & name, const rapidjson::Value & val)
+    : _name(name)
+    , _numGoals(100)
+    , _randomActions(0)
+    , _timeLimitMS(5000)
+    , _upperBound(24 * 60 * 20)
+    , _threads(1)
+    , _cacheEntries((int)BuildOrderCache::DefaultNumEntries)
+    , _seed(0)
+{
+    BOSS_ASSERT(val.HasMember("CacheFile") && val["CacheFile"].IsString(), "BuildOrderCacheWarmer must have a 'CacheFile' string");
+    _cacheFile = val["CacheFile"].GetString();
+
+    BOSS_ASSERT(val.HasMember("Races") && val["Races"].IsArray(), "BuildOrderCacheWarmer must have a 'Races' array");
+    for (size_t i(0); i < val["Races"].Size(); ++i)
+    {
+        BOSS_ASSERT(val["Races"][i].IsString(), "Races element is not a string");
+
+        const RaceID race = Races::GetRaceID(val["Races"][i].GetString());
+        BOSS_ASSERT(race < Races::NUM_RACES, "Unknown race: %s", val["Races"][i].GetString());
+
+        _races.push_back(race);
+    }
+
+    if (val.HasMember("NumGoals") && val["NumGoals"].IsInt())
+    {
+        _numGoals = val["NumGoals"].GetInt();
+    }
+
+    if (val.HasMember("RandomActions") && val["RandomActions"].IsInt())
+    {
+        _randomActions = val["RandomActions"].GetInt();
+    }
+
+    if (val.HasMember("TimeLimitMS") && val["TimeLimitMS"].IsInt())
+    {
+        _timeLimitMS = val["TimeLimitMS"].GetInt();
+    }
+
+    if (val.HasMember("UpperBound") && val["UpperBound"].IsInt())
+    {
+        _upperBound = val["UpperBound"].GetInt();
+        BOSS_ASSERT(_upperBound > 0, "BuildOrderCacheWarmer 'UpperBound' must be positive");
+    }
+
+    if (val.HasMember("Threads") && val["Threads"].IsInt())
+    {
+        _threads = val["Threads"].GetInt();
+        BOSS_ASSERT(_threads > 0, "BuildOrderCacheWarmer 'Threads' must be positive");
+    }
+
+    if (val.HasMember("CacheEntries") && val["CacheEntries"].IsInt())
+    {
+        _cacheEntries = val["CacheEntries"].GetInt();
+        BOSS_ASSERT(_cacheEntries > 0, "BuildOrderCacheWarmer 'CacheEntries' must be positive");
+    }
+
+    if (val.HasMember("Seed") && val["Seed"].IsInt())
+    {
+        _seed = (unsigned int)val["Seed"].GetInt();
+    }
+}
+
+void BuildOrderCacheWarmer::run()
+{
+    BuildOrderCache cache;
+    const bool opened = cache.open(_cacheFile, true, _cacheEntries);
+    BOSS_ASSERT(opened, "Couldn't open build order cache file: %s", _cacheFile.c_str());
+
+    srand(_seed);
+
+    std::stringstream ss;
+    char line[256];
+
+    sprintf(line, "%-12s%10s%10s%10s%10s%12s\n", "Race", "Goals", "Cached", "Solved", "Failed", "Time (ms)");
+    ss << line;
+
+    for (size_t r(0); r < _races.size(); ++r)
+    {
+        const RaceID race = _races[r];
+
+        int cached = 0;
+        int solved = 0;
+        int failed = 0;
+        double totalMS = 0;
+
+        for (int g(0); g < _numGoals; ++g)
+        {
+            const GameState state = BuildOrderTester::GetStartState(race, _randomActions);
+            const BuildOrderSearchGoal goal = BuildOrderTester::GetRandomGoal(race);
+
+            BuildOrder buildOrder;
+            if (cache.lookup(state, goal, buildOrder))
+            {
+                ++cached;
+                continue;
+            }
+
+            try
+            {
+                DFBB_BuildOrderSmartSearch search(race);
+                search.setState(state);
+                search.setGoal(goal);
+                search.setUpperBound(_upperBound);
+                search.setTimeLimit(_timeLimitMS);
+                search.setNumThreads(_threads);
+                search.search();
+
+                const DFBB_BuildOrderSearchResults & results = search.getResults();
+                totalMS += results.timeElapsed;
+
+                if (results.solved && results.solutionFound)
+                {
+                    cache.store(state, goal, results.buildOrder);
+                    ++solved;
+                }
+                else
+                {
+                    ++failed;
+                }
+            }
+            catch (const BOSSException &)
+            {
+                ++failed;
+            }
+        }
+
+        sprintf(line, "%-12s%10d%10d%10d%10d%12.0lf\n", Races::GetRaceName(race).c_str(), _numGoals, cached, solved, failed, totalMS);
+        ss << line;
+    }
+
+    sprintf(line, "\nEntries used: %d of %d\n", (int)cache.getNumUsedEntries(), (int)cache.getNumEntries());
+    ss << line;
+
+    std::cout << "\n" << _name << "\n\n" << ss.str() << std::endl;
+}
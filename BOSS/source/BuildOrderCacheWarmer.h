@@ -0,0 +1,37 @@
+#pragma once
+
+#include "BOSS.h"
+#include "BuildOrderCache.h"
+#include "JSONTools.h"
+#include "rapidjson/rapidjson.h"
+#include "rapidjson/document.h"
+
+namespace BOSS
+{
+
+// fills a build order cache file offline so the bot finds the answers instead of searching for them
+// solves 'NumGoals' random goals per race from BuildOrderTester::GetRandomGoal, starting from the
+// race's start state or, with 'RandomActions' above zero, from a state that many random actions
+// past it. only searches that finish within 'TimeLimitMS' are stored, goals the cache already
+// answers are skipped, so running it again over the same file keeps adding to it. every search starts
+// from 'UpperBound' frames instead of a naive build order, the naive search fails on many random goals
+class BuildOrderCacheWarmer
+{
+    std::string                 _name;
+    std::string                 _cacheFile;
+    std::vector<RaceID>         _races;
+    int                         _numGoals;
+    int                         _randomActions;
+    int                         _timeLimitMS;
+    int                         _upperBound;
+    int                         _threads;
+    int                         _cacheEntries;
+    unsigned int                _seed;
+
+public:
+
+    BuildOrderCacheWarmer(const std::string & name, const rapidjson::Value & experimentVal);
+
+    void run();
+};
+}
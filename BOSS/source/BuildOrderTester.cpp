@@ -45,7 +45,7 @@ void BuildOrderTester::TestRandomBuilds(const RaceID race, const size_t numTests
 {
     for (size_t i(0); i < numTests; ++i)
     {
-        GameState state = GetStartState(race, 20);            
+        GetStartState(race, 20);
     }
 }
 
@@ -1,13 +1,40 @@
 #include "CombatSearch.h"
+#include <thread>
+#include <exception>
 
 using namespace BOSS;
 
 
+CombatSearch::CombatSearch()
+    : _upperBound(0)
+    , _branchingDepth(0)
+    , _threadIndex(0)
+    , _subtreeIndex(0)
+    , _claimedSubtree(0)
+    , _nextSubtree(NULL)
+{
+
+}
+
 // function which is called to do the actual search
 void CombatSearch::search()
 {
     _searchTimer.start();
 
+    if (_params.getNumThreads() > 1)
+    {
+        searchParallel();
+    }
+    else
+    {
+        searchSerial();
+    }
+
+    _results.timeElapsed = _searchTimer.getElapsedTimeInMilliSec();
+}
+
+void CombatSearch::searchSerial()
+{
     // apply the opening build order to the initial state
     GameState initialState(_params.getInitialState());
     _buildOrder = _params.getOpeningBuildOrder();
@@ -26,8 +53,93 @@ void CombatSearch::search()
             _results.timedOut = true;
         }
     }
+}
 
-    _results.timeElapsed = _searchTimer.getElapsedTimeInMilliSec();
+// every thread searches a copy of this search, the copies share the search timer's start
+void CombatSearch::searchParallel()
+{
+    std::atomic<size_t> nextSubtree(0);
+    std::vector< std::shared_ptr<CombatSearch> > workers;
+
+    for (int t(0); t < _params.getNumThreads(); ++t)
+    {
+        std::shared_ptr<CombatSearch> worker = clone();
+        worker->_threadIndex = t;
+        worker->_nextSubtree = &nextSubtree;
+        worker->_claimedSubtree = nextSubtree++;
+
+        workers.push_back(worker);
+    }
+
+    std::vector<std::exception_ptr> threadExceptions(workers.size());
+    std::vector<std::thread> threads;
+
+    for (size_t t(0); t < workers.size(); ++t)
+    {
+        threads.push_back(std::thread([&workers, &threadExceptions, t]()
+        {
+            try
+            {
+                workers[t]->searchSerial();
+            }
+            catch (...)
+            {
+                threadExceptions[t] = std::current_exception();
+            }
+        }));
+    }
+
+    for (size_t t(0); t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+
+    for (size_t t(0); t < threadExceptions.size(); ++t)
+    {
+        if (threadExceptions[t])
+        {
+            std::rethrow_exception(threadExceptions[t]);
+        }
+    }
+
+    _results.solved = true;
+    for (size_t t(0); t < workers.size(); ++t)
+    {
+        mergeResults(*workers[t]);
+    }
+}
+
+// the children of a split node are the subtrees handed out to the threads
+bool CombatSearch::isSplitNode(const ActionSet & legalActions) const
+{
+    return (_nextSubtree != NULL) && (legalActions.size() > 1) && (_branchingDepth == (size_t)_params.getParallelSplitDepth());
+}
+
+// every thread comes to the split subtrees in the same order, a thread searches the one whose index it
+// holds and takes the next unclaimed index for itself, which is always one it has yet to come to
+bool CombatSearch::claimSubtree()
+{
+    if (_subtreeIndex++ != _claimedSubtree)
+    {
+        return false;
+    }
+
+    _claimedSubtree = (*_nextSubtree)++;
+    return true;
+}
+
+std::shared_ptr<CombatSearch> CombatSearch::clone() const
+{
+    BOSS_ASSERT(false, "Base CombatSearch can't be searched in parallel");
+
+    return std::shared_ptr<CombatSearch>();
+}
+
+void CombatSearch::mergeResults(const CombatSearch & worker)
+{
+    _results.nodesExpanded += worker._results.nodesExpanded;
+    _results.solved = _results.solved && worker._results.solved;
+    _results.timedOut = _results.timedOut || worker._results.timedOut;
 }
 
 // This functio generates the legal actions from a GameState based on the input search parameters
@@ -153,7 +265,11 @@ void CombatSearch::recurse(const GameState & state, size_t depth)
 
 void CombatSearch::updateResults(const GameState & state)
 {
-    _results.nodesExpanded++;
+    // the nodes above the split are searched by every thread, only the first one counts them
+    if ((_threadIndex == 0) || (_branchingDepth > (size_t)_params.getParallelSplitDepth()))
+    {
+        _results.nodesExpanded++;
+    }
 }
 
 void CombatSearch::printResults()
@@ -6,6 +6,8 @@
 #include "BuildOrder.h"
 #include "CombatSearchParameters.h"
 #include "CombatSearchResults.h"
+#include <atomic>
+#include <memory>
 
 namespace BOSS
 {
@@ -26,6 +28,22 @@ protected:
 
     BuildOrder                  _buildOrder;
 
+    // parallel search state, see CombatSearchParameters for how the tree is split
+    size_t                      _branchingDepth;    // nodes with more than one legal action above the current node
+    size_t                      _threadIndex;
+    size_t                      _subtreeIndex;      // split subtrees this thread has come to so far
+    size_t                      _claimedSubtree;    // index of the next split subtree this thread searches
+    std::atomic<size_t> *       _nextSubtree;       // next unclaimed split subtree, null if the search is serial
+
+    void                        searchSerial();
+    void                        searchParallel();
+    bool                        isSplitNode(const ActionSet & legalActions) const;
+    bool                        claimSubtree();
+
+    // copy of this search for a thread of the parallel search, merged back once the thread is done
+    virtual std::shared_ptr<CombatSearch> clone() const;
+    virtual void                mergeResults(const CombatSearch & worker);
+
     virtual void                recurse(const GameState & s,size_t depth);
     virtual void                generateLegalActions(const GameState & state,ActionSet & legalActions,const CombatSearchParameters & params);
 
@@ -37,6 +55,9 @@ protected:
 
 public:
 
+    CombatSearch();
+    virtual ~CombatSearch() {}
+
     virtual void                search();
     virtual void                printResults();
     virtual void                writeResultsFile(const std::string & prefix);
@@ -75,6 +75,20 @@ CombatSearchExperiment::CombatSearchExperiment(const std::string & name, const r
         _params.setAlwaysMakeWorkers(val["AlwaysMakeWorkers"].GetBool());
     }
 
+    if (val.HasMember("Threads"))
+    {
+        BOSS_ASSERT(val["Threads"].IsInt() && val["Threads"].GetInt() > 0, "Threads should be a positive int");
+
+        _params.setNumThreads(val["Threads"].GetInt());
+    }
+
+    if (val.HasMember("ParallelSplitDepth"))
+    {
+        BOSS_ASSERT(val["ParallelSplitDepth"].IsInt(), "ParallelSplitDepth should be an int");
+
+        _params.setParallelSplitDepth(val["ParallelSplitDepth"].GetInt());
+    }
+
     if (val.HasMember("OpeningBuildOrder"))
     {
         BOSS_ASSERT(val["OpeningBuildOrder"].IsString(), "OpeningBuildOrder should be a string");
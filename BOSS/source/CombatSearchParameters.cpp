@@ -15,6 +15,8 @@ CombatSearchParameters::CombatSearchParameters()
     , _useResourceLowerBoundHeuristic(false)
     , _searchTimeLimit               (0)
     , _initialUpperBound             (0)
+    , _numThreads                    (1)
+    , _parallelSplitDepth            (4)
     , _initialState                  (Races::None)
     , _maxActions                    (Constants::MAX_ACTIONS, -1)
     , _repetitionValues              (Constants::MAX_ACTIONS, 1)
@@ -109,6 +111,30 @@ void CombatSearchParameters::setFrameTimeLimit(const FrameCountType limit)
     _frameTimeLimit = limit;
 }
 
+void CombatSearchParameters::setNumThreads(const int threads)
+{
+    BOSS_ASSERT(threads > 0, "Combat search needs at least one thread");
+
+    _numThreads = threads;
+}
+
+int CombatSearchParameters::getNumThreads() const
+{
+    return _numThreads;
+}
+
+void CombatSearchParameters::setParallelSplitDepth(const int depth)
+{
+    BOSS_ASSERT(depth >= 0, "Parallel split depth can't be negative");
+
+    _parallelSplitDepth = depth;
+}
+
+int CombatSearchParameters::getParallelSplitDepth() const
+{
+    return _parallelSplitDepth;
+}
+
 void CombatSearchParameters::setAlwaysMakeWorkers(const bool flag)
 {
     _useAlwaysMakeWorkers = flag;
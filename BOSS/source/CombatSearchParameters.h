@@ -91,6 +91,20 @@ class CombatSearchParameters
 	//          it will use the value as an initial bound.
 	int		_initialUpperBound;
 			
+	//      Number of threads the combat search runs on
+	//      With more than one thread every thread searches the top of the tree down to the split
+	//          depth, and the subtrees below it are handed out one at a time to whichever thread
+	//          comes to them first. Each thread keeps its own best results, which are merged once
+	//          all threads are done. With one thread the search runs on the calling thread.
+	int     _numThreads;
+
+	//      Depth at which the parallel search splits the tree into subtrees for the threads
+	//      Only nodes with more than one legal action count toward the depth, so the chains of
+	//          forced worker builds that always make workers produces at the top of the tree don't
+	//          use it up. A deeper split gives more, smaller subtrees, at the cost of every thread
+	//          searching the nodes above it.
+	int     _parallelSplitDepth;
+
 	//      Initial GameState used for the search. See GameState.h for details
 	GameState				_initialState;
     BuildOrder              _openingBuildOrder;
@@ -136,6 +150,12 @@ public:
     void                setFrameTimeLimit(const FrameCountType limit);
     FrameCountType      getFrameTimeLimit() const;
 
+    void                setNumThreads(const int threads);
+    int                 getNumThreads() const;
+
+    void                setParallelSplitDepth(const int depth);
+    int                 getParallelSplitDepth() const;
+
     void                setAlwaysMakeWorkers(const bool flag);
     const bool          getAlwaysMakeWorkers() const;
 	
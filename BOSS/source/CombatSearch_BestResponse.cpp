@@ -27,9 +27,17 @@ void CombatSearch_BestResponse::recurse(const GameState & state, size_t depth)
 
     ActionSet legalActions;
     generateLegalActions(state, legalActions, _params);
+
+    const bool splitNode = isSplitNode(legalActions);
+    _branchingDepth += (legalActions.size() > 1) ? 1 : 0;
     
     for (UnitCountType a(0); a < legalActions.size(); ++a)
     {
+        if (splitNode && !claimSubtree())
+        {
+            continue;
+        }
+
         size_t ri = legalActions.size() - 1 - a;
 
         GameState child(state);
@@ -40,6 +48,23 @@ void CombatSearch_BestResponse::recurse(const GameState & state, size_t depth)
 
         _buildOrder.pop_back();
     }
+
+    _branchingDepth -= (legalActions.size() > 1) ? 1 : 0;
+}
+
+std::shared_ptr<CombatSearch> CombatSearch_BestResponse::clone() const
+{
+    std::shared_ptr<CombatSearch_BestResponse> worker(new CombatSearch_BestResponse(*this));
+    worker->_bestResponseData.setPrintNewBest(false);
+
+    return worker;
+}
+
+void CombatSearch_BestResponse::mergeResults(const CombatSearch & worker)
+{
+    CombatSearch::mergeResults(worker);
+
+    _bestResponseData.merge(static_cast<const CombatSearch_BestResponse &>(worker)._bestResponseData);
 }
 
 void CombatSearch_BestResponse::printResults()
@@ -16,6 +16,9 @@ class CombatSearch_BestResponse : public CombatSearch
 {
 	virtual void                    recurse(const GameState & s, size_t depth);
 
+    virtual std::shared_ptr<CombatSearch> clone() const;
+    virtual void                    mergeResults(const CombatSearch & worker);
+
     CombatSearch_BestResponseData   _bestResponseData;
 
     BuildOrder                      _bestBuildOrder;
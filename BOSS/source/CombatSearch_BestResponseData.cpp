@@ -6,6 +6,7 @@ CombatSearch_BestResponseData::CombatSearch_BestResponseData(const GameState & e
     : _enemyInitialState(enemyState)
     , _enemyBuildOrder(enemyBuildOrder)
     , _bestEval(std::numeric_limits<double>::max())
+    , _printNewBest(true)
 {
     // compute enemy army values
 
@@ -34,10 +35,28 @@ void CombatSearch_BestResponseData::update(const GameState & initialState, const
         _bestBuildOrder = buildOrder;
         _bestState = currentState;
 
-        std::cout << eval/Constants::RESOURCE_SCALE << "   " << _bestBuildOrder.getNameString(2) << std::endl;
+        if (_printNewBest)
+        {
+            std::cout << eval/Constants::RESOURCE_SCALE << "   " << _bestBuildOrder.getNameString(2) << std::endl;
+        }
+    }
+}
+
+void CombatSearch_BestResponseData::merge(const CombatSearch_BestResponseData & other)
+{
+    if (other._bestEval < _bestEval)
+    {
+        _bestEval = other._bestEval;
+        _bestBuildOrder = other._bestBuildOrder;
+        _bestState = other._bestState;
     }
 }
 
+void CombatSearch_BestResponseData::setPrintNewBest(const bool print)
+{
+    _printNewBest = print;
+}
+
 double CombatSearch_BestResponseData::compareBuildOrder(const GameState & initialState, const BuildOrder & buildOrder)
 {
     calculateArmyValues(initialState, buildOrder, _selfArmyValues);
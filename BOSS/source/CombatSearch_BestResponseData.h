@@ -20,6 +20,7 @@ class CombatSearch_BestResponseData
     double                  _bestEval;
     BuildOrder              _bestBuildOrder;
     GameState               _bestState;
+    bool                    _printNewBest;
 
     double compareBuildOrder(const GameState & state, const BuildOrder & buildOrder);
     size_t getStateIndex(const GameState & state);
@@ -31,6 +32,8 @@ public:
     CombatSearch_BestResponseData(const GameState & enemyState, const BuildOrder & enemyBuildOrder);
 
     void update(const GameState & initialState, const GameState & currentState, const BuildOrder & buildOrder);
+    void merge(const CombatSearch_BestResponseData & other);
+    void setPrintNewBest(const bool print);
 
     const BuildOrder & getBestBuildOrder() const;
 
@@ -9,7 +9,7 @@ CombatSearch_Bucket::CombatSearch_Bucket(const CombatSearchParameters p)
    
     BOSS_ASSERT(_params.getInitialState().getRace() != Races::None, "Combat search initial state is invalid");
 }
-void CombatSearch_Bucket::doSearch(const GameState & state, size_t depth)
+void CombatSearch_Bucket::recurse(const GameState & state, size_t depth)
 {
     if (timeLimitReached())
     {
@@ -31,17 +31,39 @@ void CombatSearch_Bucket::doSearch(const GameState & state, size_t depth)
 
     ActionSet legalActions;
     generateLegalActions(state, legalActions, _params);
+
+    const bool splitNode = isSplitNode(legalActions);
+    _branchingDepth += (legalActions.size() > 1) ? 1 : 0;
     
     for (UnitCountType a(0); a < legalActions.size(); ++a)
     {
+        if (splitNode && !claimSubtree())
+        {
+            continue;
+        }
+
         GameState child(state);
         child.doAction(legalActions[a]);
         _buildOrder.add(legalActions[a]);
         
-        doSearch(child,depth+1);
+        recurse(child,depth+1);
 
         _buildOrder.pop_back();
     }
+
+    _branchingDepth -= (legalActions.size() > 1) ? 1 : 0;
+}
+
+std::shared_ptr<CombatSearch> CombatSearch_Bucket::clone() const
+{
+    return std::shared_ptr<CombatSearch>(new CombatSearch_Bucket(*this));
+}
+
+void CombatSearch_Bucket::mergeResults(const CombatSearch & worker)
+{
+    CombatSearch::mergeResults(worker);
+
+    _bucket.merge(static_cast<const CombatSearch_Bucket &>(worker)._bucket);
 }
 
 void CombatSearch_Bucket::printResults()
@@ -16,7 +16,10 @@ class CombatSearch_Bucket : public CombatSearch
 {
     CombatSearch_BucketData     _bucket;
 
-	virtual void                doSearch(const GameState & s, size_t depth);
+	virtual void                recurse(const GameState & s, size_t depth);
+
+    virtual std::shared_ptr<CombatSearch> clone() const;
+    virtual void                mergeResults(const CombatSearch & worker);
 
 public:
 	
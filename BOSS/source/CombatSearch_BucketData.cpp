@@ -60,6 +60,22 @@ void CombatSearch_BucketData::update(const GameState & state, const BuildOrder &
     }
 }
 
+// both sets of buckets only grow with time, so keeping the better of each bucket keeps that true
+void CombatSearch_BucketData::merge(const CombatSearch_BucketData & other)
+{
+    BOSS_ASSERT(other._buckets.size() == _buckets.size(), "Merging bucket data with a different number of buckets");
+
+    for (size_t b(0); b < _buckets.size(); ++b)
+    {
+        const BucketData & otherBucket = other._buckets[b];
+
+        if ((otherBucket.eval > _buckets[b].eval) || ((otherBucket.eval == _buckets[b].eval) && Eval::BuildOrderBetter(otherBucket.buildOrder, _buckets[b].buildOrder)))
+        {
+            _buckets[b] = otherBucket;
+        }
+    }
+}
+
 bool CombatSearch_BucketData::isDominated(const GameState & state)
 {
     return Eval::StateDominates(getBucketData(state).state, state);
@@ -37,6 +37,7 @@ public:
     const size_t getBucketIndex(const GameState & state) const;
         
     void update(const GameState & state, const BuildOrder & buildOrder);
+    void merge(const CombatSearch_BucketData & other);
 
     bool isDominated(const GameState & state);
 
@@ -9,7 +9,7 @@ CombatSearch_Integral::CombatSearch_Integral(const CombatSearchParameters p)
     BOSS_ASSERT(_params.getInitialState().getRace() != Races::None, "Combat search initial state is invalid");
 }
 
-void CombatSearch_Integral::doSearch(const GameState & state, size_t depth)
+void CombatSearch_Integral::recurse(const GameState & state, size_t depth)
 {
     if (timeLimitReached())
     {
@@ -25,9 +25,17 @@ void CombatSearch_Integral::doSearch(const GameState & state, size_t depth)
 
     ActionSet legalActions;
     generateLegalActions(state, legalActions, _params);
+
+    const bool splitNode = isSplitNode(legalActions);
+    _branchingDepth += (legalActions.size() > 1) ? 1 : 0;
     
     for (UnitCountType a(0); a < legalActions.size(); ++a)
     {
+        if (splitNode && !claimSubtree())
+        {
+            continue;
+        }
+
         const UnitCountType index = legalActions.size()-1-a;
 
         GameState child(state);
@@ -35,11 +43,28 @@ void CombatSearch_Integral::doSearch(const GameState & state, size_t depth)
         _buildOrder.add(legalActions[index]);
         _integral.update(state, _buildOrder);
         
-        doSearch(child,depth+1);
+        recurse(child,depth+1);
 
         _buildOrder.pop_back();
         _integral.pop();
     }
+
+    _branchingDepth -= (legalActions.size() > 1) ? 1 : 0;
+}
+
+std::shared_ptr<CombatSearch> CombatSearch_Integral::clone() const
+{
+    std::shared_ptr<CombatSearch_Integral> worker(new CombatSearch_Integral(*this));
+    worker->_integral.setPrintNewBest(false);
+
+    return worker;
+}
+
+void CombatSearch_Integral::mergeResults(const CombatSearch & worker)
+{
+    CombatSearch::mergeResults(worker);
+
+    _integral.merge(static_cast<const CombatSearch_Integral &>(worker)._integral);
 }
 
 void CombatSearch_Integral::printResults()
@@ -4,6 +4,7 @@ using namespace BOSS;
 
 CombatSearch_IntegralData::CombatSearch_IntegralData()
     : _bestIntegralValue(0)
+    , _printNewBest(true)
 {
     _integralStack.push_back(IntegralData(0,0,0));
 }
@@ -27,10 +28,30 @@ void CombatSearch_IntegralData::update(const GameState & state, const BuildOrder
         _bestIntegralBuildOrder = buildOrder;
 
         // print the newly found best to console
-        printIntegralData(_integralStack.size()-1);
+        if (_printNewBest)
+        {
+            printIntegralData(_integralStack.size()-1);
+        }
     }
 }
 
+// keeps the better of the two bests, by the same rule update uses
+void CombatSearch_IntegralData::merge(const CombatSearch_IntegralData & other)
+{
+    if (    (other._bestIntegralValue >  _bestIntegralValue) 
+        || ((other._bestIntegralValue == _bestIntegralValue) && Eval::BuildOrderBetter(other._bestIntegralBuildOrder, _bestIntegralBuildOrder)))
+    {
+        _bestIntegralValue = other._bestIntegralValue;
+        _bestIntegralStack = other._bestIntegralStack;
+        _bestIntegralBuildOrder = other._bestIntegralBuildOrder;
+    }
+}
+
+void CombatSearch_IntegralData::setPrintNewBest(const bool print)
+{
+    _printNewBest = print;
+}
+
 void CombatSearch_IntegralData::pop()
 {
     _integralStack.pop_back();
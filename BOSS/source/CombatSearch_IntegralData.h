@@ -39,6 +39,7 @@ class CombatSearch_IntegralData
     std::vector<IntegralData>       _bestIntegralStack;
     double                          _bestIntegralValue;
     BuildOrder                      _bestIntegralBuildOrder;
+    bool                            _printNewBest;
 
 public:
 
@@ -46,6 +47,8 @@ public:
 
     void update(const GameState & state, const BuildOrder & buildOrder);
     void pop();
+    void merge(const CombatSearch_IntegralData & other);
+    void setPrintNewBest(const bool print);
 
     void printIntegralData(const size_t index) const;
     void print() const;
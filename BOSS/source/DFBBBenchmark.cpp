@@ -0,0 +1,138 @@
+#include "DFBBBenchmark.h"
+
+using namespace BOSS;
+
+DFBBBenchmark::DFBBBenchmark(const std::string & name, const rapidjson::Value & val)
+    : _name(name)
+    , _timeLimitMS(5000)
+    , _threads(1)
+{
+    BOSS_ASSERT(val.HasMember("BuildOrderDir") && val["BuildOrderDir"].IsString(), "DFBBBenchmark must have a 'BuildOrderDir' string");
+    _buildOrderDir = val["BuildOrderDir"].GetString();
+
+    BOSS_ASSERT(val.HasMember("BuildOrders") && val["BuildOrders"].IsArray(), "DFBBBenchmark must have a 'BuildOrders' array");
+    for (size_t i(0); i < val["BuildOrders"].Size(); ++i)
+    {
+        BOSS_ASSERT(val["BuildOrders"][i].IsString(), "BuildOrders element is not a string");
+
+        _buildOrderFiles.push_back(val["BuildOrders"][i].GetString());
+    }
+
+    if (val.HasMember("TimeLimitMS") && val["TimeLimitMS"].IsInt())
+    {
+        _timeLimitMS = val["TimeLimitMS"].GetInt();
+    }
+
+    if (val.HasMember("Threads") && val["Threads"].IsInt())
+    {
+        _threads = val["Threads"].GetInt();
+        BOSS_ASSERT(_threads > 0, "DFBBBenchmark 'Threads' must be positive");
+    }
+
+    if (val.HasMember("OutputFile") && val["OutputFile"].IsString())
+    {
+        _outputFile = val["OutputFile"].GetString();
+    }
+}
+
+void DFBBBenchmark::ReadBuildOrderFile(const std::string & filename, RaceID & race, BuildOrder & buildOrder)
+{
+    std::ifstream fin(filename.c_str());
+    BOSS_ASSERT(fin.is_open(), "Couldn't open build order file: %s", filename.c_str());
+
+    std::string raceName;
+    fin >> raceName;
+    race = Races::GetRaceID(raceName);
+    BOSS_ASSERT(race < Races::NUM_RACES, "Unknown race in build order file %s: %s", filename.c_str(), raceName.c_str());
+
+    std::string actionName;
+    while (fin >> actionName)
+    {
+        BOSS_ASSERT(ActionTypes::TypeExists(actionName), "Action Type doesn't exist: %s", actionName.c_str());
+
+        buildOrder.add(ActionTypes::GetActionType(actionName));
+    }
+}
+
+// ask for everything the build order produced
+BuildOrderSearchGoal DFBBBenchmark::getGoal(const GameState & initialState, const GameState & finalState) const
+{
+    const RaceID race = initialState.getRace();
+
+    BuildOrderSearchGoal goal(race);
+    for (size_t a(0); a < ActionTypes::GetAllActionTypes(race).size(); ++a)
+    {
+        const ActionType & actionType = ActionTypes::GetActionType(race, a);
+
+        if (actionType.isWorker() || actionType.isSupplyProvider() || actionType.isResourceDepot() || actionType.isRefinery())
+        {
+            continue;
+        }
+
+        const UnitCountType numTotal = finalState.getUnitData().getNumTotal(actionType);
+        if (numTotal > initialState.getUnitData().getNumTotal(actionType))
+        {
+            goal.setGoal(actionType, numTotal);
+        }
+    }
+
+    return goal;
+}
+
+void DFBBBenchmark::run()
+{
+    std::stringstream ss;
+    char line[256];
+
+    sprintf(line, "%-32s%14s%12s%14s%12s%8s%10s%10s\n", "Build Order", "Nodes", "Time (ms)", "Nodes/Sec", "Dominated", "Solved", "Script", "Makespan");
+    ss << line;
+
+    unsigned long long totalNodes = 0;
+    double totalMS = 0;
+
+    for (size_t i(0); i < _buildOrderFiles.size(); ++i)
+    {
+        RaceID race = Races::None;
+        BuildOrder buildOrder;
+        ReadBuildOrderFile(_buildOrderDir + _buildOrderFiles[i], race, buildOrder);
+
+        GameState initialState(race);
+        initialState.setStartingState();
+
+        GameState finalState(initialState);
+        BOSS_ASSERT(buildOrder.isLegalFromState(finalState), "Build order is not legal from the start state: %s", buildOrder.whyIsNotLegalFromState(finalState).c_str());
+        buildOrder.doActions(finalState);
+
+        const FrameCountType scriptMakespan = finalState.getLastActionFinishTime();
+
+        DFBB_BuildOrderSmartSearch search(race);
+        search.setState(initialState);
+        search.setGoal(getGoal(initialState, finalState));
+        search.setUpperBound(scriptMakespan);
+        search.setTimeLimit(_timeLimitMS);
+        search.setNumThreads(_threads);
+        search.search();
+
+        const DFBB_BuildOrderSearchResults & results = search.getResults();
+        const double nodesPerSec = results.timeElapsed > 0 ? results.nodesExpanded / (results.timeElapsed / 1000.0) : 0;
+
+        totalNodes += results.nodesExpanded;
+        totalMS += results.timeElapsed;
+
+        // the makespan stays the script's if the search found nothing faster
+        sprintf(line, "%-32s%14llu%12.0lf%14.0lf%12llu%8s%10d%10d\n", _buildOrderFiles[i].c_str(), results.nodesExpanded, results.timeElapsed, nodesPerSec, 
+            results.tablePrunes, results.solved ? "yes" : "no", scriptMakespan, results.solutionFound ? results.upperBound : scriptMakespan);
+        ss << line;
+    }
+
+    sprintf(line, "%-32s%14llu%12.0lf%14.0lf\n", "Total", totalNodes, totalMS, totalMS > 0 ? totalNodes / (totalMS / 1000.0) : 0);
+    ss << line;
+
+    std::cout << "\n" << _name << "\n\n" << ss.str() << std::endl;
+
+    if (_outputFile.length() > 0)
+    {
+        std::ofstream fout(_outputFile.c_str());
+        fout << ss.str();
+    }
+}
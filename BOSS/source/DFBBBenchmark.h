@@ -0,0 +1,37 @@
+#pragma once
+
+#include "BOSS.h"
+#include "JSONTools.h"
+#include "rapidjson/rapidjson.h"
+#include "rapidjson/document.h"
+
+namespace BOSS
+{
+
+// measures DFBB search speed on goals taken from build order files
+// each file holds a race name followed by one action name per line, the goal is every unit, tech
+// and upgrade the build order ends up with except workers, supply, refineries and resource depots,
+// which the smart search plans on its own. the build order itself is the initial upper bound, so
+// every search starts out knowing one solution. reports nodes expanded per second for every goal,
+// 'Threads' above one runs the searches in parallel
+class DFBBBenchmark
+{
+    std::string                 _name;
+    std::string                 _buildOrderDir;
+    std::string                 _outputFile;
+    std::vector<std::string>    _buildOrderFiles;
+    int                         _timeLimitMS;
+    int                         _threads;
+
+    BuildOrderSearchGoal        getGoal(const GameState & initialState, const GameState & finalState) const;
+
+public:
+
+    // reads a build order file, a race name followed by one action name per line
+    static void                 ReadBuildOrderFile(const std::string & filename, RaceID & race, BuildOrder & buildOrder);
+
+    DFBBBenchmark(const std::string & name, const rapidjson::Value & experimentVal);
+
+    void run();
+};
+}
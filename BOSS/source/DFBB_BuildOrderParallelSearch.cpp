@@ -0,0 +1,247 @@
+#include "DFBB_BuildOrderParallelSearch.h"
+#include <exception>
+
+using namespace BOSS;
+
+DFBB_BuildOrderParallelSearch::DFBB_BuildOrderParallelSearch(const DFBB_BuildOrderSearchParameters & p)
+    : _params(p)
+    , _upperBound(0)
+    , _stop(false)
+    , _stepNumber(0)
+    , _threadsRunning(0)
+    , _threadBudget(0)
+    , _shutdown(false)
+    , _firstSearch(true)
+{
+    BOSS_ASSERT(_params.numThreads > 0, "Parallel search needs at least one thread");
+}
+
+DFBB_BuildOrderParallelSearch::~DFBB_BuildOrderParallelSearch()
+{
+    stopThreads();
+}
+
+void DFBB_BuildOrderParallelSearch::setTimeLimit(double ms)
+{
+    _params.searchTimeLimit = ms;
+}
+
+void DFBB_BuildOrderParallelSearch::search()
+{
+    step(_params.searchTimeLimit * 1000);
+}
+
+// searches for at most budgetMicros microseconds, zero means until the search is finished
+void DFBB_BuildOrderParallelSearch::step(const double budgetMicros)
+{
+    if (_results.solved)
+    {
+        return;
+    }
+
+    _searchTimer.start();
+
+    if (_firstSearch)
+    {
+        createWorkers();
+        _firstSearch = false;
+    }
+
+    // the threads get what is left of the budget after setting up
+    double threadBudget = 0;
+    if (budgetMicros > 0)
+    {
+        threadBudget = std::max(1.0, budgetMicros - _searchTimer.getElapsedTimeInMicroSec());
+    }
+
+    // wake the waiting threads for one more step and wait until all of them are done with it
+    {
+        std::unique_lock<std::mutex> lock(_stepMutex);
+
+        _stop = false;
+        _threadBudget = threadBudget;
+        _threadsRunning = _threads.size();
+        ++_stepNumber;
+
+        _stepReady.notify_all();
+        _stepDone.wait(lock, [this]() { return _threadsRunning == 0; });
+    }
+
+    for (size_t t(0); t < _threadExceptions.size(); ++t)
+    {
+        if (_threadExceptions[t])
+        {
+            std::exception_ptr exception = _threadExceptions[t];
+            stopThreads();
+            std::rethrow_exception(exception);
+        }
+    }
+
+    mergeResults();
+
+    // a solved search is never stepped again
+    if (_results.solved)
+    {
+        stopThreads();
+    }
+}
+
+void DFBB_BuildOrderParallelSearch::runThread(const size_t t)
+{
+    size_t stepsRun = 0;
+
+    while (true)
+    {
+        double budget = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(_stepMutex);
+            _stepReady.wait(lock, [this, &stepsRun]() { return _shutdown || _stepNumber != stepsRun; });
+
+            if (_shutdown)
+            {
+                return;
+            }
+
+            stepsRun = _stepNumber;
+            budget = _threadBudget;
+        }
+
+        try
+        {
+            _workers[t].startWorkerClock(budget);
+            runWorker(_workers[t]);
+        }
+        catch (...)
+        {
+            _threadExceptions[t] = std::current_exception();
+            _stop = true;
+        }
+
+        std::lock_guard<std::mutex> lock(_stepMutex);
+        if (--_threadsRunning == 0)
+        {
+            _stepDone.notify_one();
+        }
+    }
+}
+
+void DFBB_BuildOrderParallelSearch::stopThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(_stepMutex);
+        _shutdown = true;
+        _stepReady.notify_all();
+    }
+
+    for (size_t t(0); t < _threads.size(); ++t)
+    {
+        _threads[t].join();
+    }
+
+    _threads.clear();
+}
+
+void DFBB_BuildOrderParallelSearch::createWorkers()
+{
+    int upperBound = _params.initialUpperBound ? _params.initialUpperBound : Tools::GetUpperBound(_params.initialState, _params.goal);
+
+    // add one frame to the upper bound so our strictly lesser than check still works if we have an exact upper bound
+    _upperBound = upperBound + 1;
+
+    DFBB_BuildOrderSearchParameters threadParams(_params);
+    threadParams.numThreads = 1;
+
+    _splitter = std::make_shared<DFBB_BuildOrderStackSearch>(threadParams);
+    _splitter->setSharedBounds(&_upperBound, &_stop);
+
+    _workers.assign(_params.numThreads, DFBB_BuildOrderStackSearch(threadParams));
+    for (size_t t(0); t < _workers.size(); ++t)
+    {
+        _workers[t].setSharedBounds(&_upperBound, &_stop);
+    }
+
+    _threadExceptions.assign(_workers.size(), std::exception_ptr());
+    for (size_t t(0); t < _workers.size(); ++t)
+    {
+        _threads.push_back(std::thread([this, t]() { runThread(t); }));
+    }
+}
+
+bool DFBB_BuildOrderParallelSearch::nextWorkItem(DFBB_WorkItem & item)
+{
+    std::lock_guard<std::mutex> lock(_splitMutex);
+
+    return _splitter->nextWorkItem(item);
+}
+
+// a thread that runs out of time keeps the item it was searching, the items nobody has taken
+// yet are still unexpanded in the splitter, so a later step loses no part of the tree
+void DFBB_BuildOrderParallelSearch::runWorker(DFBB_BuildOrderStackSearch & worker)
+{
+    if (worker.wasInterrupted() && !worker.resumeWorkItem())
+    {
+        return;
+    }
+
+    DFBB_WorkItem item(_params.initialState, BuildOrder());
+
+    while (!_stop && nextWorkItem(item))
+    {
+        if (!worker.searchWorkItem(item))
+        {
+            return;
+        }
+    }
+}
+
+// sums the nodes of every thread and keeps the best solution any of them found
+void DFBB_BuildOrderParallelSearch::mergeResults()
+{
+    _splitResults = _splitter->getResults();
+
+    const DFBB_BuildOrderSearchResults * best = _splitResults.solutionFound ? &_splitResults : nullptr;
+    unsigned long long nodesExpanded = _splitResults.nodesExpanded;
+    unsigned long long tableHits = _splitResults.tableHits;
+    unsigned long long tablePrunes = _splitResults.tablePrunes;
+    bool timedOut = false;
+
+    for (size_t t(0); t < _workers.size(); ++t)
+    {
+        const DFBB_BuildOrderSearchResults & threadResults = _workers[t].getResults();
+
+        nodesExpanded += threadResults.nodesExpanded;
+        tableHits += threadResults.tableHits;
+        tablePrunes += threadResults.tablePrunes;
+        timedOut = timedOut || _workers[t].wasInterrupted();
+
+        if (threadResults.solutionFound && (!best || threadResults.upperBound < best->upperBound))
+        {
+            best = &threadResults;
+        }
+    }
+
+    if (best)
+    {
+        _results.buildOrder = best->buildOrder;
+        _results.finalState = best->finalState;
+        _results.upperBound = best->upperBound;
+        _results.solutionFound = true;
+    }
+    else
+    {
+        _results.upperBound = _upperBound;
+    }
+
+    _results.nodesExpanded = nodesExpanded;
+    _results.tableHits = tableHits;
+    _results.tablePrunes = tablePrunes;
+    _results.timedOut = timedOut;
+    _results.solved = !timedOut;
+    _results.timeElapsed = _searchTimer.getElapsedTimeInMilliSec();
+}
+
+const DFBB_BuildOrderSearchResults & DFBB_BuildOrderParallelSearch::getResults() const
+{
+    return _results;
+}
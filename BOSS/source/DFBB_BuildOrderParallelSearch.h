@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Common.h"
+#include "DFBB_BuildOrderStackSearch.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+
+namespace BOSS
+{
+
+// multi threaded DFBB search
+// the top levels of the search tree are expanded into work items which threads take from a shared
+// splitter as they finish their previous one, the splitter only expands the tree up to the next item
+// so no item is made before a thread is free to search it. every thread prunes against one atomic upper bound, so
+// the best solution found by any thread bounds all of them. a timed out search can be resumed by
+// calling search again, every thread first finishes the work item it was interrupted in
+// the threads are started by the first step and wait between steps until the search is solved or
+// destroyed, so short search slices don't pay for starting and joining them every time
+// each thread keeps its own dominance table, states visited by other threads are not pruned
+class DFBB_BuildOrderParallelSearch
+{
+    DFBB_BuildOrderSearchParameters         _params;
+    DFBB_BuildOrderSearchResults            _results;
+    DFBB_BuildOrderSearchResults            _splitResults;
+
+    Timer                                   _searchTimer;
+
+    std::shared_ptr<DFBB_BuildOrderStackSearch> _splitter;
+    std::mutex                              _splitMutex;
+    std::vector<DFBB_BuildOrderStackSearch> _workers;
+
+    std::atomic<int>                        _upperBound;
+    std::atomic<bool>                       _stop;
+
+    // worker threads, each runs its worker once per step number and then counts itself done
+    std::vector<std::thread>                _threads;
+    std::vector<std::exception_ptr>         _threadExceptions;
+    std::mutex                              _stepMutex;
+    std::condition_variable                 _stepReady;
+    std::condition_variable                 _stepDone;
+    size_t                                  _stepNumber;
+    size_t                                  _threadsRunning;
+    double                                  _threadBudget;
+    bool                                    _shutdown;
+
+    bool                                    _firstSearch;
+
+    void                                    createWorkers();
+    void                                    stopThreads();
+    void                                    runThread(const size_t t);
+    bool                                    nextWorkItem(DFBB_WorkItem & item);
+    void                                    runWorker(DFBB_BuildOrderStackSearch & worker);
+    void                                    mergeResults();
+
+public:
+
+    DFBB_BuildOrderParallelSearch(const DFBB_BuildOrderSearchParameters & p);
+    ~DFBB_BuildOrderParallelSearch();
+
+    void setTimeLimit(double ms);
+    void search();
+    void step(const double budgetMicros);
+    const DFBB_BuildOrderSearchResults & getResults() const;
+};
+}
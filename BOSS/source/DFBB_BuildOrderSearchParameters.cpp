@@ -12,8 +12,12 @@ DFBB_BuildOrderSearchParameters::DFBB_BuildOrderSearchParameters(const RaceID &
     , supplyBoundingThreshold(1)
     , useLandmarkLowerBoundHeuristic(true)
     , useResourceLowerBoundHeuristic(true)
+    , useDominanceTable(false)
+    , dominanceTableSize(1 << 14)
     , searchTimeLimit(0)
     , initialUpperBound(0)
+    , numThreads(1)
+    , parallelSplitDepth(5)
     , repetitionValues(Constants::MAX_ACTIONS, 1)
     , repetitionThresholds(Constants::MAX_ACTIONS, 0)
     , goal(r)
@@ -67,6 +71,8 @@ std::string DFBB_BuildOrderSearchParameters::toString() const
     ss << (useResourceLowerBoundHeuristic ?    "\tUSE      Resource Lower Bound\n" : "");
     ss << (useAlwaysMakeWorkers ?              "\tUSE      Always Make Workers\n" : "");
     ss << (useSupplyBounding ?                 "\tUSE      Supply Bounding\n" : "");
+    ss << (useDominanceTable ?                 "\tUSE      Dominance Table\n" : "");
+    ss << (numThreads > 1 ?                    "\tUSE      Parallel Search\n" : "");
     ss << ("\n");
 
     for (ActionID a(0); a < repetitionValues.size(); ++a)
@@ -71,11 +71,23 @@ public:
     bool useLandmarkLowerBoundHeuristic;
     bool useResourceLowerBoundHeuristic;
 
+    //      Flag which determines whether or not we prune states dominated by a state visited earlier
+    //      Different orders of the same actions often lead to states with the same units where
+    //          one of them is simply ahead of the other. Visited states are kept in a hash table
+    //          of dominanceTableSize entries, and a state is not searched if a visited state with
+    //          the same units was there no later, with at least as many resources and with its
+    //          actions in progress finishing no later. Each entry is about 220 bytes.
+    //
+    //      true:  dominated states are pruned
+    //      false: dominated states are searched
+    bool useDominanceTable;
+    size_t dominanceTableSize;
+
     //      Search time limit measured in milliseconds
     //      If searchTimeLimit is set to a value greater than zero, the search will effectively
-    //          time out and the best solution so far will be used in the results. This is
-    //          accomplished by throwing an exception if the time limit is hit. Time is checked
-    //          once every 1000 nodes expanded, as checking the time is slow.
+    //          time out and the best solution so far will be used in the results. The search
+    //          stops where it is and can be continued later. See DFBB_SearchClock for how the
+    //          time is measured.
     double searchTimeLimit;
 
     //      Initial upper bound for the DFBB search
@@ -84,6 +96,21 @@ public:
     //          it will use the value as an initial bound.
     int initialUpperBound;
 
+    //      Number of threads used by the DFBB search
+    //      If numThreads is greater than one, the top of the search tree is expanded
+    //          until parallelSplitDepth levels with more than one legal action have been
+    //          passed, and every node below them becomes a work item. Items are made one at
+    //          a time as threads become free, not all before the search starts.
+    //          The work items are searched by a pool of threads which all prune against a
+    //          shared upper bound, so a solution found by any thread tightens the search of
+    //          all the others. Without a time limit the makespan found is the same as a
+    //          single threaded search, but the build order can differ when several have the
+    //          same makespan since work items are not finished in order.
+    //
+    //      parallelSplitDepth should be deep enough to give several work items per thread
+    int numThreads;
+    int parallelSplitDepth;
+
     //      StarcraftSearchGoal used for the search. See StarcraftSearchGoal.hpp for details
     BuildOrderSearchGoal goal;
 
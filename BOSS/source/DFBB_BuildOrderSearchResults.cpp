@@ -8,6 +8,8 @@ DFBB_BuildOrderSearchResults::DFBB_BuildOrderSearchResults()
     , solutionFound(false)
     , upperBound(0)
     , nodesExpanded(0)
+    , tableHits(0)
+    , tablePrunes(0)
     , timeElapsed(0)
 {
 }
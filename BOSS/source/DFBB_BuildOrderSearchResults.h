@@ -21,6 +21,8 @@ public:
 	int					        upperBound;		// upper bound of first node
 	
 	unsigned long long 	        nodesExpanded;	// number of nodes expanded in the search
+    unsigned long long          tableHits;      // states whose units were already in the dominance table
+    unsigned long long          tablePrunes;    // states pruned because a visited state dominated them
 	
 	double 				        timeElapsed;	// time elapsed in milliseconds
 
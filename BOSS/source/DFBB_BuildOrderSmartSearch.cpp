@@ -8,20 +8,17 @@ DFBB_BuildOrderSmartSearch::DFBB_BuildOrderSmartSearch(const RaceID race)
     , _goal(race)
     , _stackSearch(race)
     , _searchTimeLimit(30)
+    , _searchStarted(false)
 {
 }
 
-void DFBB_BuildOrderSmartSearch::doSearch()
+// starts the search on the first call and continues it on later ones, until it is solved
+void DFBB_BuildOrderSmartSearch::doSearch(const double budgetMicros)
 {
     BOSS_ASSERT(_initialState.getRace() != Races::None, "Must set initial state before performing search");
 
-    // if we are resuming a search
-    if (_stackSearch.getResults().timedOut)
-    {
-        _stackSearch.setTimeLimit(_searchTimeLimit);
-        _stackSearch.search();
-    }
-    else
+    // if we haven't started searching yet, set up a new search
+    if (!_searchStarted)
     {
         calculateSearchSettings();
         _params.goal = _goal;
@@ -31,15 +28,33 @@ void DFBB_BuildOrderSmartSearch::doSearch()
         _params.useAlwaysMakeWorkers 		= true;
         _params.useSupplyBounding 			= true;
         _params.supplyBoundingThreshold     = 1.5;
+        _params.useDominanceTable           = true;
         _params.relevantActions             = _relevantActions;
         _params.searchTimeLimit             = _searchTimeLimit;
 
         //BWAPI::Broodwar->printf("Constructing new search object time limit is %lf", _params.searchTimeLimit);
-        _stackSearch = DFBB_BuildOrderStackSearch(_params);
-        _stackSearch.search();
+        if (_params.numThreads > 1)
+        {
+            _parallelSearch = std::make_shared<DFBB_BuildOrderParallelSearch>(_params);
+        }
+        else
+        {
+            _stackSearch = DFBB_BuildOrderStackSearch(_params);
+        }
+
+        _searchStarted = true;
     }
 
-    _results = _stackSearch.getResults();
+    if (_params.numThreads > 1)
+    {
+        _parallelSearch->step(budgetMicros);
+        _results = _parallelSearch->getResults();
+    }
+    else
+    {
+        _stackSearch.step(budgetMicros);
+        _results = _stackSearch.getResults();
+    }
 
     if (_results.solved && !_results.solutionFound)
     {
@@ -286,19 +301,23 @@ const RaceID DFBB_BuildOrderSmartSearch::getRace() const
     return _race;
 }
 
+// changing the goal or the state starts a new search on the next call
 void DFBB_BuildOrderSmartSearch::addGoal(const ActionType & a, const UnitCountType count)
 {
     _goal.setGoal(a,count);
+    _searchStarted = false;
 }
 
 void DFBB_BuildOrderSmartSearch::setGoal(const BuildOrderSearchGoal & g)
 {
     _goal = g;    
+    _searchStarted = false;
 }
 
 void DFBB_BuildOrderSmartSearch::setState(const GameState & state)
 {
     _initialState = state;
+    _searchStarted = false;
 }
 
 
@@ -307,9 +326,32 @@ void DFBB_BuildOrderSmartSearch::setTimeLimit(int n)
     _searchTimeLimit = n;
 }
 
+// a known solution length, the search then skips computing its own upper bound with the naive build order
+void DFBB_BuildOrderSmartSearch::setUpperBound(const FrameCountType frame)
+{
+    _params.initialUpperBound = frame;
+}
+
+// the number of threads the search uses, see DFBB_BuildOrderSearchParameters::numThreads
+void DFBB_BuildOrderSmartSearch::setNumThreads(const int threads)
+{
+    BOSS_ASSERT(threads > 0, "Search needs at least one thread");
+
+    _params.numThreads = threads;
+}
+
 void DFBB_BuildOrderSmartSearch::search()
 {
-    doSearch();
+    doSearch(_searchTimeLimit * 1000);
+}
+
+// searches for at most budgetMicros microseconds and returns the best build order found so far
+// calling it once per frame gives the search a slice of every frame until getResults().solved
+const BuildOrder & DFBB_BuildOrderSmartSearch::step(const double budgetMicros)
+{
+    doSearch(budgetMicros);
+
+    return _results.buildOrder;
 }
 
 const DFBB_BuildOrderSearchResults & DFBB_BuildOrderSmartSearch::getResults() const
@@ -3,6 +3,8 @@
 #include "Common.h"
 #include "GameState.h"
 #include "DFBB_BuildOrderStackSearch.h"
+#include "DFBB_BuildOrderParallelSearch.h"
+#include <memory>
 #include "Timer.hpp"
 
 namespace BOSS
@@ -18,15 +20,17 @@ class DFBB_BuildOrderSmartSearch
 
 	GameState					        _initialState;
 	
-	int 							    _searchTimeLimit;
+	double 							    _searchTimeLimit;
+    bool                                _searchStarted;
 
 	Timer							    _searchTimer;
 
     DFBB_BuildOrderStackSearch          _stackSearch;
+    std::shared_ptr<DFBB_BuildOrderParallelSearch> _parallelSearch;
 
     DFBB_BuildOrderSearchResults        _results;
 	
-	void doSearch();
+	void doSearch(const double budgetMicros);
 	void calculateSearchSettings();
 	void setPrerequisiteGoalMax();
 	void recurseOverStrictDependencies(const ActionType & action);
@@ -47,8 +51,11 @@ public:
 	void setState(const GameState & state);
 	void print();
 	void setTimeLimit(int n);
+	void setUpperBound(const FrameCountType frame);
+	void setNumThreads(const int threads);
 	
 	void search();
+    const BuildOrder & step(const double budgetMicros);
 
     const DFBB_BuildOrderSearchResults & getResults() const;
 	const DFBB_BuildOrderSearchParameters & getParameters();
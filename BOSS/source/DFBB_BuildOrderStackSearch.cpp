@@ -4,10 +4,14 @@ using namespace BOSS;
 
 DFBB_BuildOrderStackSearch::DFBB_BuildOrderStackSearch(const DFBB_BuildOrderSearchParameters & p)
     : _params(p)
+    , _stack(100, StackData())
     , _depth(0)
+    , _dominanceTable(p.useDominanceTable ? p.dominanceTableSize : 0)
     , _firstSearch(true)
     , _wasInterrupted(false)
-    , _stack(100, StackData())
+    , _splitStarted(false)
+    , _sharedUpperBound(nullptr)
+    , _sharedStop(nullptr)
 {
     
 }
@@ -17,10 +21,19 @@ void DFBB_BuildOrderStackSearch::setTimeLimit(double ms)
     _params.searchTimeLimit = ms;
 }
 
-// function which is called to do the actual search
+// searches until the time limit in the parameters runs out, see step
 void DFBB_BuildOrderStackSearch::search()
 {
-    _searchTimer.start();
+    step(_params.searchTimeLimit * 1000);
+}
+
+// searches for at most budgetMicros microseconds, or until the search is finished if the budget is zero
+// running out of time leaves the search stack as it is, so the next step continues where this one stopped
+void DFBB_BuildOrderStackSearch::step(const double budgetMicros)
+{
+    BOSS_ASSERT(_params.numThreads <= 1, "Use DFBB_BuildOrderParallelSearch for a multi threaded search");
+
+    _clock.start(budgetMicros, _results.nodesExpanded);
 
     if (!_results.solved)
     {
@@ -37,25 +50,12 @@ void DFBB_BuildOrderStackSearch::search()
             //std::cout << "Upper bound is: " << _results.upperBound << std::endl;
         }
 
-        try 
-        {
-            // search on the initial state
-            DFBB();
+        // search on the initial state, or continue the interrupted search
+        DFBB();
 
-            _results.timedOut = false;
-        }
-        catch (int e) 
-        {
-            if (e == DFBB_TIMEOUT_EXCEPTION)
-            {
-                //BWAPI::Broodwar->printf("I timed out!");
-                _results.timedOut = true;
-            }
-        }
-        
-        double ms = _searchTimer.getElapsedTimeInMilliSec();
+        _results.timedOut = _wasInterrupted;
         _results.solved = !_results.timedOut;
-        _results.timeElapsed = ms;
+        _results.timeElapsed = _clock.getElapsedTimeInMilliSec();
     }
 }
 
@@ -174,7 +174,34 @@ UnitCountType DFBB_BuildOrderStackSearch::getRepetitions(const GameState & state
 
 bool DFBB_BuildOrderStackSearch::isTimeOut()
 {
-    return (_params.searchTimeLimit && (_results.nodesExpanded % 200 == 0) && (_searchTimer.getElapsedTimeInMilliSec() > _params.searchTimeLimit));
+    if (_sharedStop && _sharedStop->load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+
+    if (_clock.isTimeUp(_results.nodesExpanded))
+    {
+        // one thread running out of time stops every thread of a parallel search
+        if (_sharedStop)
+        {
+            _sharedStop->store(true);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+// the best makespan found by this search or by any other thread of a parallel search
+int DFBB_BuildOrderStackSearch::getUpperBound() const
+{
+    if (_sharedUpperBound)
+    {
+        return std::min(_results.upperBound, _sharedUpperBound->load(std::memory_order_relaxed));
+    }
+
+    return _results.upperBound;
 }
 
 void DFBB_BuildOrderStackSearch::updateResults(const GameState & state)
@@ -182,18 +209,88 @@ void DFBB_BuildOrderStackSearch::updateResults(const GameState & state)
     FrameCountType finishTime = state.getLastActionFinishTime();
 
     // new best solution
-    if (finishTime < _results.upperBound)
+    if (finishTime < getUpperBound())
     {
-        _results.timeElapsed = _searchTimer.getElapsedTimeInMilliSec();
+        _results.timeElapsed = _clock.getElapsedTimeInMilliSec();
         _results.upperBound = finishTime;
         _results.solutionFound = true;
         _results.finalState = state;
         _results.buildOrder = _buildOrder;
 
+        // lower the shared bound unless another thread has beaten us to a better one
+        if (_sharedUpperBound)
+        {
+            int sharedBound = _sharedUpperBound->load();
+            while (finishTime < sharedBound && !_sharedUpperBound->compare_exchange_weak(sharedBound, finishTime))
+            {
+            
+            }
+        }
+
         //_results.printResults(true);
     }
 }
 
+// checks the state against the dominance table, which also records it as visited
+bool DFBB_BuildOrderStackSearch::isDominated(const GameState & state)
+{
+    if (!_params.useDominanceTable)
+    {
+        return false;
+    }
+
+    bool keyFound = false;
+    const bool dominated = _dominanceTable.isDominated(state, keyFound);
+
+    _results.tableHits += keyFound ? 1 : 0;
+    _results.tablePrunes += dominated ? 1 : 0;
+
+    return dominated;
+}
+
+void DFBB_BuildOrderStackSearch::setSharedBounds(std::atomic<int> * upperBound, std::atomic<bool> * stop)
+{
+    _sharedUpperBound = upperBound;
+    _sharedStop = stop;
+    _results.upperBound = upperBound->load();
+    _firstSearch = false;
+}
+
+void DFBB_BuildOrderStackSearch::startWorkerClock(const double budgetMicros)
+{
+    _clock.start(budgetMicros, _results.nodesExpanded);
+}
+
+// searches the subtree below the work item, returns false if the search was interrupted
+bool DFBB_BuildOrderStackSearch::searchWorkItem(const DFBB_WorkItem & item)
+{
+    _stack[0].state = item.state;
+    _buildOrder = item.buildOrder;
+    _depth = 0;
+
+    return runWorkItem();
+}
+
+// continues the work item this search was interrupted in
+bool DFBB_BuildOrderStackSearch::resumeWorkItem()
+{
+    BOSS_ASSERT(_wasInterrupted, "No interrupted work item to resume");
+
+    return runWorkItem();
+}
+
+bool DFBB_BuildOrderStackSearch::runWorkItem()
+{
+    DFBB();
+
+    return !_wasInterrupted;
+}
+
+bool DFBB_BuildOrderStackSearch::wasInterrupted() const
+{
+    return _wasInterrupted;
+}
+
 #define ACTION_TYPE     _stack[_depth].currentActionType
 #define STATE           _stack[_depth].state
 #define CHILD_STATE     _stack[_depth+1].state
@@ -206,21 +303,26 @@ void DFBB_BuildOrderStackSearch::updateResults(const GameState & state)
 #define DFBB_CALL_RECURSE { ++_depth; goto SEARCH_BEGIN; }
 
 // recursive function which does all search logic
+// the recursion lives on _stack, so running out of time just returns with the stack intact and the
+// next call starts again by expanding the node at _depth, which hadn't been expanded yet
 void DFBB_BuildOrderStackSearch::DFBB()
 {
     FrameCountType actionFinishTime = 0;
     FrameCountType heuristicTime = 0;
     FrameCountType maxHeuristic = 0;
 
-SEARCH_BEGIN:
+    _wasInterrupted = false;
 
-    _results.nodesExpanded++;
+SEARCH_BEGIN:
 
     if (isTimeOut())
     {
-        throw DFBB_TIMEOUT_EXCEPTION;
+        _wasInterrupted = true;
+        return;
     }
 
+    _results.nodesExpanded++;
+
     generateLegalActions(STATE, LEGAL_ACTINS);
     for (CHILD_NUM = 0; CHILD_NUM < LEGAL_ACTINS.size(); ++CHILD_NUM)
     {
@@ -230,7 +332,7 @@ SEARCH_BEGIN:
         heuristicTime    = STATE.getCurrentFrame() + Tools::GetLowerBound(STATE, _params.goal);
         maxHeuristic     = (actionFinishTime > heuristicTime) ? actionFinishTime : heuristicTime;
 
-        if (maxHeuristic > _results.upperBound)
+        if (maxHeuristic > getUpperBound())
         {
             continue;
         }
@@ -258,7 +360,7 @@ SEARCH_BEGIN:
         {
             updateResults(CHILD_STATE);
         }
-        else
+        else if (!isDominated(CHILD_STATE))
         {
             DFBB_CALL_RECURSE;
         }
@@ -272,4 +374,112 @@ SEARCH_RETURN:
     }
 
     DFBB_CALL_RETURN;
-}
\ No newline at end of file
+}
+
+// hands out the work items of a parallel search one at a time, false once there are none left
+// the top of the tree is expanded the same way DFBB does until parallelSplitDepth levels with more
+// than one legal action have been passed, every node below them is a work item. goals reached on
+// the way are recorded as solutions. always make workers often leaves only one legal action near
+// the root, those levels don't count or every item would share the same first few actions
+// the expansion lives on _stack like DFBB's, so each call continues from the item before it and
+// only ever expands the nodes between two items
+bool DFBB_BuildOrderStackSearch::nextWorkItem(DFBB_WorkItem & item)
+{
+    if (!_splitStarted)
+    {
+        _splitStarted = true;
+        _buildOrder.clear();
+        _depth = 0;
+        STATE = _params.initialState;
+
+        // the whole tree is the only work item
+        if (_params.parallelSplitDepth <= 0)
+        {
+            LEGAL_ACTINS.clear();
+            CHILD_NUM = 0;
+            item = DFBB_WorkItem(STATE, _buildOrder);
+            return true;
+        }
+
+        expandSplitNode(0);
+    }
+
+    while (true)
+    {
+        // every child of this node has been split, continue with the next child of its parent
+        if (CHILD_NUM >= LEGAL_ACTINS.size())
+        {
+            if (_depth == 0)
+            {
+                return false;
+            }
+
+            --_depth;
+            finishSplitChild();
+            continue;
+        }
+
+        ACTION_TYPE = LEGAL_ACTINS[CHILD_NUM];
+
+        FrameCountType actionFinishTime = STATE.whenCanPerform(ACTION_TYPE) + ACTION_TYPE.buildTime();
+        FrameCountType heuristicTime    = STATE.getCurrentFrame() + Tools::GetLowerBound(STATE, _params.goal);
+
+        if (std::max(actionFinishTime, heuristicTime) > getUpperBound())
+        {
+            ++CHILD_NUM;
+            continue;
+        }
+
+        REPETITIONS = getRepetitions(STATE, ACTION_TYPE);
+        BOSS_ASSERT(REPETITIONS > 0, "Can't have zero repetitions!");
+
+        CHILD_STATE = STATE;
+        for (COMPLETED_REPS = 0; COMPLETED_REPS < REPETITIONS && CHILD_STATE.isLegal(ACTION_TYPE); ++COMPLETED_REPS)
+        {
+            _buildOrder.add(ACTION_TYPE);
+            CHILD_STATE.doAction(ACTION_TYPE);
+        }
+
+        const int childSplitDepth = LEGAL_ACTINS.size() > 1 ? _stack[_depth].splitDepth + 1 : _stack[_depth].splitDepth;
+
+        if (_params.goal.isAchievedBy(CHILD_STATE))
+        {
+            updateResults(CHILD_STATE);
+        }
+        else if (!isDominated(CHILD_STATE))
+        {
+            if (childSplitDepth >= _params.parallelSplitDepth)
+            {
+                item = DFBB_WorkItem(CHILD_STATE, _buildOrder);
+                finishSplitChild();
+                return true;
+            }
+
+            ++_depth;
+            expandSplitNode(childSplitDepth);
+            continue;
+        }
+
+        finishSplitChild();
+    }
+}
+
+void DFBB_BuildOrderStackSearch::expandSplitNode(const int splitDepth)
+{
+    _results.nodesExpanded++;
+
+    _stack[_depth].splitDepth = splitDepth;
+    generateLegalActions(STATE, LEGAL_ACTINS);
+    CHILD_NUM = 0;
+}
+
+// takes the actions of the current child of the node at _depth off the build order and moves to the next child
+void DFBB_BuildOrderStackSearch::finishSplitChild()
+{
+    for (UnitCountType r(0); r < COMPLETED_REPS; ++r)
+    {
+        _buildOrder.pop_back();
+    }
+
+    ++CHILD_NUM;
+}
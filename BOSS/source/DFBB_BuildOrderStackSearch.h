@@ -4,11 +4,11 @@
 #include "ActionType.h"
 #include "DFBB_BuildOrderSearchResults.h"
 #include "DFBB_BuildOrderSearchParameters.h"
-#include "Timer.hpp"
+#include "DFBB_SearchClock.h"
 #include "Tools.h"
 #include "BuildOrder.h"
-
-#define DFBB_TIMEOUT_EXCEPTION 1
+#include "DFBB_DominanceTable.h"
+#include <atomic>
 
 namespace BOSS
 {
@@ -23,11 +23,29 @@ public:
     ActionType          currentActionType;
     UnitCountType       repetitionValue;
     UnitCountType       completedRepetitions;
+    int                 splitDepth;                 //levels with more than one legal action above this node, only used when splitting
     
     StackData()
         : currentChildIndex(0)
         , repetitionValue(1)
         , completedRepetitions(0)
+        , splitDepth(0)
+    {
+    
+    }
+};
+
+// a subtree of the search handed to one thread of a parallel search
+class DFBB_WorkItem
+{
+public:
+
+    GameState           state;
+    BuildOrder          buildOrder;
+
+    DFBB_WorkItem(const GameState & s, const BuildOrder & b)
+        : state(s)
+        , buildOrder(b)
     {
     
     }
@@ -38,18 +56,30 @@ class DFBB_BuildOrderStackSearch
 	DFBB_BuildOrderSearchParameters     _params;                      //parameters that will be used in this search
 	DFBB_BuildOrderSearchResults        _results;                     //the results of the search so far
 					
-    Timer                               _searchTimer;
+    DFBB_SearchClock                    _clock;
     BuildOrder                          _buildOrder;
 
     std::vector<StackData>              _stack;
     size_t                              _depth;
 
+    DFBB_DominanceTable                 _dominanceTable;
+
     bool                                _firstSearch;
 
     bool                                _wasInterrupted;
+
+    bool                                _splitStarted;
+
+    std::atomic<int> *                  _sharedUpperBound;            //bound shared by all threads of a parallel search, null otherwise
+    std::atomic<bool> *                 _sharedStop;                  //set when any thread of a parallel search times out
     
     void                                updateResults(const GameState & state);
     bool                                isTimeOut();
+    int                                 getUpperBound() const;
+    bool                                isDominated(const GameState & state);
+    bool                                runWorkItem();
+    void                                expandSplitNode(const int splitDepth);
+    void                                finishSplitChild();
     void                                calculateRecursivePrerequisites(const ActionType & action, ActionSet & all);
     void                                generateLegalActions(const GameState & state, ActionSet & legalActions);
 	std::vector<ActionType>             getBuildOrder(GameState & state);
@@ -62,9 +92,18 @@ public:
 	
     void setTimeLimit(double ms);
 	void search();
+    void step(const double budgetMicros);
     const DFBB_BuildOrderSearchResults & getResults() const;
 	
 	void DFBB();
+
+    // used by DFBB_BuildOrderParallelSearch to run this search as one of its threads
+    void setSharedBounds(std::atomic<int> * upperBound, std::atomic<bool> * stop);
+    void startWorkerClock(const double budgetMicros);
+    bool nextWorkItem(DFBB_WorkItem & item);
+    bool searchWorkItem(const DFBB_WorkItem & item);
+    bool resumeWorkItem();
+    bool wasInterrupted() const;
 	
 	
 };
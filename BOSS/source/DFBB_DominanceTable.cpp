@@ -0,0 +1,169 @@
+#include "DFBB_DominanceTable.h"
+
+using namespace BOSS;
+
+DFBB_DominanceEntry::DFBB_DominanceEntry()
+    : key(0)
+    , frame(0)
+    , minerals(0)
+    , gas(0)
+    , nextLarvaFrame(0)
+    , numInProgress(0)
+{
+
+}
+
+// entries are only allocated once the table is first used, search objects get copied around before
+// they search and most of them never do
+DFBB_DominanceTable::DFBB_DominanceTable(const size_t size)
+    : _size(size - (size % BucketSize))
+    , _nextReplaced(0)
+{
+    BOSS_ASSERT(size == 0 || _size > 0, "Dominance table must hold at least %d states", (int)BucketSize);
+}
+
+void DFBB_DominanceTable::clear()
+{
+    _entries.clear();
+    _nextReplaced = 0;
+}
+
+// FNV-1a step over a whole value instead of a byte
+void DFBB_DominanceTable::MixKey(unsigned long long & key, const unsigned long long value)
+{
+    key = (key ^ value) * 1099511628211ULL;
+}
+
+unsigned long long DFBB_DominanceTable::GetKey(const GameState & state)
+{
+    const UnitData & units = state.getUnitData();
+    const size_t numActions = ActionTypes::GetAllActionTypes(state.getRace()).size();
+
+    unsigned long long key = 14695981039346656037ULL;
+
+    MixKey(key, state.getRace());
+    MixKey(key, units.getNumMineralWorkers());
+    MixKey(key, units.getNumGasWorkers());
+    MixKey(key, units.getNumBuildingWorkers());
+
+    // larva is used from the hatchery with the most, so only the sorted per hatchery counts matter
+    const HatcheryData & hatcheries = units.getHatcheryData();
+    UnitCountType larva[Constants::MAX_HATCHERIES];
+    for (UnitCountType h(0); h < hatcheries.size(); ++h)
+    {
+        larva[h] = hatcheries.getHatchery(h).numLarva();
+    }
+
+    std::sort(larva, larva + hatcheries.size());
+
+    MixKey(key, hatcheries.size());
+    for (UnitCountType h(0); h < hatcheries.size(); ++h)
+    {
+        MixKey(key, larva[h]);
+    }
+
+    for (size_t a(0); a < numActions; ++a)
+    {
+        const ActionType & action = ActionTypes::GetActionType(state.getRace(), (ActionID)a);
+
+        MixKey(key, (unsigned long long)units.getNumCompleted(action) << 16 | units.getNumInProgress(action));
+    }
+
+    // zero marks an unused entry
+    return key ? key : 1;
+}
+
+void DFBB_DominanceTable::GetEntry(const GameState & state, DFBB_DominanceEntry & entry)
+{
+    const UnitData & units = state.getUnitData();
+
+    entry.key = GetKey(state);
+    entry.frame = state.getCurrentFrame();
+    entry.minerals = state.getMinerals();
+    entry.gas = state.getGas();
+    entry.nextLarvaFrame = units.getHatcheryData().size() > 0 ? units.getHatcheryData().nextLarvaFrameAfter(entry.frame) : 0;
+    entry.numInProgress = units.getNumActionsInProgress();
+
+    // in progress actions are kept in finish time order, group them by type so the same key always
+    // lines up the same types at the same index
+    std::pair<ActionID, FrameCountType> inProgress[Constants::MAX_PROGRESS];
+    for (UnitCountType i(0); i < entry.numInProgress; ++i)
+    {
+        inProgress[i] = std::make_pair(units.getActionInProgressByIndex(i).ID(), units.getActionInProgressFinishTimeByIndex(i));
+    }
+
+    std::sort(inProgress, inProgress + entry.numInProgress);
+
+    for (UnitCountType i(0); i < entry.numInProgress; ++i)
+    {
+        entry.finishTimes[i] = inProgress[i].second;
+    }
+}
+
+bool DFBB_DominanceTable::Dominates(const DFBB_DominanceEntry & entry, const DFBB_DominanceEntry & other)
+{
+    if ((entry.key != other.key) || (entry.frame > other.frame) || (entry.minerals < other.minerals) || (entry.gas < other.gas)
+        || (entry.nextLarvaFrame > other.nextLarvaFrame))
+    {
+        return false;
+    }
+
+    for (UnitCountType i(0); i < entry.numInProgress; ++i)
+    {
+        if (entry.finishTimes[i] > other.finishTimes[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DFBB_DominanceTable::isDominated(const GameState & state, bool & keyFound)
+{
+    keyFound = false;
+
+    if (_size == 0)
+    {
+        return false;
+    }
+
+    if (_entries.empty())
+    {
+        _entries.resize(_size);
+    }
+
+    DFBB_DominanceEntry entry;
+    GetEntry(state, entry);
+
+    const size_t bucket = (size_t)(entry.key % (_size / BucketSize)) * BucketSize;
+    size_t replace = bucket + (_nextReplaced++ % BucketSize);
+
+    for (size_t i(bucket); i < bucket + BucketSize; ++i)
+    {
+        DFBB_DominanceEntry & visited = _entries[i];
+
+        if (visited.key == entry.key)
+        {
+            keyFound = true;
+
+            if (Dominates(visited, entry))
+            {
+                return true;
+            }
+
+            // a visited state this one dominates is no longer worth keeping
+            if (Dominates(entry, visited))
+            {
+                replace = i;
+            }
+        }
+        else if (visited.key == 0)
+        {
+            replace = i;
+        }
+    }
+
+    _entries[replace] = entry;
+    return false;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Common.h"
+#include "GameState.h"
+
+namespace BOSS
+{
+
+// a state visited by the search, reduced to what decides whether it dominates another state
+class DFBB_DominanceEntry
+{
+public:
+
+    unsigned long long      key;                                    // hash of the state without time and resources, 0 if unused
+    FrameCountType          frame;
+    ResourceCountType       minerals;
+    ResourceCountType       gas;
+    FrameCountType          nextLarvaFrame;                         // frame the next zerg larva spawns, 0 for other races
+    UnitCountType           numInProgress;
+    FrameCountType          finishTimes[Constants::MAX_PROGRESS];   // actions in progress ordered by action ID then finish time
+
+    DFBB_DominanceEntry();
+};
+
+// table of states visited by DFBB, used to prune states reached by another order of the same actions
+// two states with the same key have the same completed units, the same actions in progress and the
+// same worker assignment. a visited state dominates a new state with the same key if it was at the same
+// or an earlier frame with at least as many resources and its actions in progress finish no later,
+// everything the search could do from the new state it could then do as early from the visited one
+// for zerg the larva count of every hatchery is part of the key and the visited state's next larva must
+// spawn no later, so waiting from it gives each hatchery at least as many larva as the new state has
+class DFBB_DominanceTable
+{
+    static const size_t                 BucketSize = 4;
+
+    std::vector<DFBB_DominanceEntry>    _entries;
+    size_t                              _size;
+    size_t                              _nextReplaced;
+
+    static void                         MixKey(unsigned long long & key, const unsigned long long value);
+    static unsigned long long           GetKey(const GameState & state);
+    static void                         GetEntry(const GameState & state, DFBB_DominanceEntry & entry);
+    static bool                         Dominates(const DFBB_DominanceEntry & entry, const DFBB_DominanceEntry & other);
+
+public:
+
+    DFBB_DominanceTable(const size_t size = 0);
+
+    // true if a visited state dominates this one, otherwise the state is recorded as visited
+    // keyFound is set if a visited state had the same key, whether or not it dominates
+    bool                                isDominated(const GameState & state, bool & keyFound);
+    void                                clear();
+};
+}
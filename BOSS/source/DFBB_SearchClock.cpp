@@ -0,0 +1,62 @@
+#include "DFBB_SearchClock.h"
+
+using namespace BOSS;
+
+DFBB_SearchClock::DFBB_SearchClock()
+    : _budgetMicros(0)
+    , _nodesPerMicro(0)
+    , _startNodes(0)
+    , _nodeLimit(0)
+{
+
+}
+
+void DFBB_SearchClock::start(const double budgetMicros, const unsigned long long nodes)
+{
+    _timer.start();
+    _budgetMicros = budgetMicros;
+    _startNodes = nodes;
+    _nodeLimit = std::numeric_limits<unsigned long long>::max();
+
+    if (_budgetMicros > 0 && _nodesPerMicro > 0)
+    {
+        _nodeLimit = nodes + (unsigned long long)(_budgetMicros * _nodesPerMicro);
+    }
+}
+
+bool DFBB_SearchClock::isTimeUp(const unsigned long long nodes)
+{
+    if (_budgetMicros <= 0)
+    {
+        return false;
+    }
+
+    if ((nodes < _nodeLimit) && ((nodes - _startNodes) % TimerCheckInterval != 0 || _timer.getElapsedTimeInMicroSec() <= _budgetMicros))
+    {
+        return false;
+    }
+
+    measureSpeed(nodes);
+    return true;
+}
+
+// the speed of the next slice is predicted from an average over the slices so far, which follows
+// the search as its nodes get cheaper or more expensive deeper in the tree
+void DFBB_SearchClock::measureSpeed(const unsigned long long nodes)
+{
+    const double elapsed = _timer.getElapsedTimeInMicroSec();
+
+    // too short a slice says more about the timer than about the search
+    if (elapsed < 100)
+    {
+        return;
+    }
+
+    const double nodesPerMicro = (nodes - _startNodes) / elapsed;
+    _nodesPerMicro = _nodesPerMicro > 0 ? (_nodesPerMicro + nodesPerMicro) / 2 : nodesPerMicro;
+}
+
+double DFBB_SearchClock::getElapsedTimeInMilliSec()
+{
+    return _timer.getElapsedTimeInMilliSec();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Common.h"
+#include "Timer.hpp"
+
+namespace BOSS
+{
+
+// decides when a time slice of a DFBB search is used up
+// the node count is the clock: a slice may expand as many nodes as the speed measured over earlier
+// slices says fit in its budget, so slices stop at the same point of the search however often the
+// bot calls it. the real timer is only read every few nodes, as a guard for slices running slower
+// than predicted and for the first slice, before any speed has been measured
+class DFBB_SearchClock
+{
+    static const unsigned long long     TimerCheckInterval = 16;
+
+    Timer                               _timer;
+    double                              _budgetMicros;
+    double                              _nodesPerMicro;
+    unsigned long long                  _startNodes;
+    unsigned long long                  _nodeLimit;
+
+    void                                measureSpeed(const unsigned long long nodes);
+
+public:
+
+    DFBB_SearchClock();
+
+    // starts a slice of budgetMicros microseconds, zero means no limit
+    void                                start(const double budgetMicros, const unsigned long long nodes);
+    bool                                isTimeUp(const unsigned long long nodes);
+    double                              getElapsedTimeInMilliSec();
+};
+}
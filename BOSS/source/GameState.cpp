@@ -1,7 +1,10 @@
 #include "GameState.h"
+#include <type_traits>
 
 using namespace BOSS;
 
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must stay trivially copyable so search copies never allocate");
+
 
 GameState::GameState(const RaceID r)
     : _race                 (r)
@@ -336,14 +339,12 @@ bool GameState::isLegal(const ActionType & action) const
 }
 
 // do an action, action must be legal for this not to break
-std::vector<ActionType> GameState::doAction(const ActionType & action)
+// the actions that finish while fast forwarding to it are appended to finished if given
+void GameState::doAction(const ActionType & action, FinishedActions * finished)
 {
     BOSS_ASSERT(action.getRace() == _race, "Race of action does not match race of the state");
 
-    _actionsPerformed.push_back(ActionPerformed());
-    _actionsPerformed[_actionsPerformed.size()-1].actionType = action;
-
-    BOSS_ASSERT(isLegal(action), "Trying to perform an illegal action: %s %s", action.getName().c_str(), getActionsPerformedString().c_str());
+    BOSS_ASSERT(isLegal(action), "Trying to perform an illegal action: %s %s", action.getName().c_str(), whyIsNotLegal(action).c_str());
     
     // set the actionPerformed
     _actionPerformed = action;
@@ -356,11 +357,7 @@ std::vector<ActionType> GameState::doAction(const ActionType & action)
 
     BOSS_ASSERT(ffTime >= 0 && ffTime < 1000000, "FFTime is very strange: %d", ffTime);
 
-    auto actionsFinished = fastForward(ffTime);
-
-    _actionsPerformed[_actionsPerformed.size()-1].actionQueuedFrame = _currentFrame;
-    _actionsPerformed[_actionsPerformed.size()-1].gasWhenQueued = _gas;
-    _actionsPerformed[_actionsPerformed.size()-1].mineralsWhenQueued = _minerals;
+    fastForward(ffTime, finished);
 
     // how much time has elapsed since the last action was queued?
     FrameCountType elapsed(_currentFrame - _lastActionFrame);
@@ -414,12 +411,10 @@ std::vector<ActionType> GameState::doAction(const ActionType & action)
             _units.addActionInProgress(action, _currentFrame + action.buildTime());
         }
      }
-
-	return actionsFinished;
 }
 
-// fast forwards the current state to time toFrame
-std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame)
+// fast forwards the current state to time toFrame, appending the actions that finish to finished if given
+void GameState::fastForward(const FrameCountType toFrame, FinishedActions * finished)
 {
     // fast forward the building timers to the current frame
     FrameCountType previousFrame = _currentFrame;
@@ -431,8 +426,6 @@ std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame)
     ResourceCountType   moreGas             = 0;
     ResourceCountType   moreMinerals        = 0;
 
-
-	std::vector<ActionType> actionsFinished;
     // while we still have units in progress
     while ((_units.getNumActionsInProgress() > 0) && (_units.getNextActionFinishTime() <= toFrame))
     {
@@ -448,7 +441,12 @@ std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame)
         lastActionFinished 	= _units.getNextActionFinishTime();
 
         // finish the action, which updates mineral and gas rates if required
-		actionsFinished.push_back(_units.finishNextActionInProgress());
+        const ActionType action = _units.finishNextActionInProgress();
+
+        if (finished)
+        {
+            finished->push_back(action);
+        }
     }
 
     // update resources from the last action finished to toFrame
@@ -467,8 +465,6 @@ std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame)
     {
         _units.getHatcheryData().fastForward(previousFrame, toFrame);
     }
-
-	return actionsFinished;
 }
 
 // returns the time at which all resources to perform an action will be available
@@ -617,11 +613,6 @@ const FrameCountType GameState::whenSupplyReady(const ActionType & action) const
 
 const FrameCountType GameState::whenPrerequisitesReady(const ActionType & action) const
 {
-    if (action == ActionTypes::GetActionType("Protoss_Dark_Templar"))
-    {
-        int a = 6;
-    }
-
     FrameCountType preReqReadyTime = _currentFrame;
 
     // if a building builds this action
@@ -713,93 +704,8 @@ const FrameCountType GameState::whenMineralsReady(const ActionType & action) con
     {
         return getCurrentFrame();
     }
-    
-    UnitCountType currentMineralWorkers     = _units.getNumMineralWorkers();
-    UnitCountType currentGasWorkers         = _units.getNumGasWorkers();
-    FrameCountType lastActionFinishFrame    = _currentFrame;
-    FrameCountType addedTime                = 0;
-    ResourceCountType addedMinerals         = 0;
-    ResourceCountType difference            = action.mineralPrice() - _minerals;
-
-    // loop through each action in progress, adding the minerals we would gather from each interval
-    for (size_t i(0); i<_units.getNumActionsInProgress(); ++i)
-    {
-        // the vector is sorted in descending order
-        size_t progressIndex = _units.getNumActionsInProgress() - i - 1;
-
-        // the time elapsed and the current minerals per frame
-        FrameCountType elapsed = _units.getFinishTimeByIndex(progressIndex) - lastActionFinishFrame;
-        ResourceCountType mineralsPerFrame = (currentMineralWorkers * Constants::MPWPF);
-
-        // the amount of minerals that would be added this time step
-        ResourceCountType tempAdd = elapsed * mineralsPerFrame;
-
-        // if this amount isn't enough, update the amount added for this interval
-        if (addedMinerals + tempAdd < difference)
-        {
-            addedMinerals += tempAdd;
-            addedTime += elapsed;
-        }
-        else
-        {
-            // otherwise we can just break out and update at the end
-            break;
-        }
-
-        // if it was a drone or extractor update the temp variables
-        const ActionType & actionPerformed = _units.getActionInProgressByIndex(progressIndex);
-
-        // finishing a building as terran gives you a mineral worker back
-        if (actionPerformed.isBuilding() && !actionPerformed.isAddon() && (getRace() == Races::Terran))
-        {
-            currentMineralWorkers++;
-        }
-
-        if (actionPerformed.isWorker())
-        {
-            currentMineralWorkers++;
-        }
-        else if (actionPerformed.isRefinery())
-        {
-            BOSS_ASSERT(currentMineralWorkers > 3, "Not enough mineral workers \n");
-            currentMineralWorkers -= 3; 
-            currentGasWorkers += 3;
-        }
-
-
-        // update the last action
-        lastActionFinishFrame = _units.getFinishTimeByIndex(progressIndex);
-    }
-
-    // if we still haven't added enough minerals, add more time
-    if (addedMinerals < difference)
-    {
-        BOSS_ASSERT(currentMineralWorkers > 0, "Shouldn't have 0 mineral workers");
-
-       FrameCountType finalTimeToAdd;
-	   if (currentMineralWorkers != 0)
-		{
-			finalTimeToAdd = (difference - addedMinerals) / (currentMineralWorkers * Constants::MPWPF);
-		}
-		else
-		{
-			finalTimeToAdd = 1000000;
-		}
-        addedMinerals += finalTimeToAdd * currentMineralWorkers * Constants::MPWPF;
-        addedTime     += finalTimeToAdd;
 
-        // the last operation could have added one frame too little due to integer division so we need to check
-        if (addedMinerals < difference)
-        {
-            addedTime += 1;
-            addedMinerals += currentMineralWorkers * Constants::MPWPF;
-        }
-    }
-    
-    BOSS_ASSERT(addedMinerals >= difference, "Mineral prediction error");
-
-    // for some reason if i don't return +1, i mine 1 less mineral in the interval
-    return _currentFrame + addedTime;
+    return whenIncomeReaches(action.mineralPrice() - _minerals, false);
 }
 
 const FrameCountType GameState::whenGasReady(const ActionType & action) const
@@ -808,90 +714,40 @@ const FrameCountType GameState::whenGasReady(const ActionType & action) const
     {
         return getCurrentFrame();
     }
-    
-    UnitCountType currentMineralWorkers     = _units.getNumMineralWorkers();
-    UnitCountType currentGasWorkers         = _units.getNumGasWorkers();
-    FrameCountType lastActionFinishFrame    = _currentFrame;
-    FrameCountType addedTime                = 0;
-    ResourceCountType addedGas              = 0;
-    ResourceCountType difference            = action.gasPrice() - _gas;
-
-    // loop through each action in progress, adding the minerals we would gather from each interval
-    for (size_t i(0); i<_units.getNumActionsInProgress(); ++i)
-    {
-        // the vector is sorted in descending order
-        size_t progressIndex = _units.getNumActionsInProgress() - i - 1;
-
-        // the time elapsed and the current minerals per frame
-        FrameCountType elapsed = _units.getFinishTimeByIndex(progressIndex) - lastActionFinishFrame;
-        ResourceCountType gasPerFrame = (currentGasWorkers * Constants::GPWPF);
-
-        // the amount of minerals that would be added this time step
-        ResourceCountType tempAdd = elapsed * gasPerFrame;
 
-        // if this amount isn't enough, update the amount added for this interval
-        if (addedGas + tempAdd < difference)
-        {
-            addedGas += tempAdd;
-            addedTime += elapsed;
-        }
-        else
-        {
-            // otherwise we can just break out and update at the end
-            break;
-        }
+    return whenIncomeReaches(action.gasPrice() - _gas, true);
+}
 
-        // if it was a drone or extractor update the temp variables
-        const ActionType & actionPerformed = _units.getActionInProgressByIndex(progressIndex);
+// the frame at which we will have gathered amount more minerals or gas
+// income is linear between the frames at which actions in progress finish, so each piece of the
+// timeline is added whole until the one containing the answer, which is solved directly
+const FrameCountType GameState::whenIncomeReaches(const ResourceCountType amount, const bool gas) const
+{
+    const ResourceCountType perWorker   = gas ? Constants::GPWPF : Constants::MPWPF;
+    ResourceCountType workers           = gas ? _units.getNumGasWorkers() : _units.getNumMineralWorkers();
+    FrameCountType pieceStart           = _currentFrame;
+    ResourceCountType added             = 0;
 
-        // finishing a building as terran gives you a mineral worker back
-        if (actionPerformed.isBuilding() && !actionPerformed.isAddon() && (getRace() == Races::Terran))
-        {
-            currentMineralWorkers++;
-        }
+    // the actions in progress are sorted in descending order of finish time
+    for (size_t i(_units.getNumActionsInProgress()); i > 0; --i)
+    {
+        const ActionInProgress & next = _units.getActionInProgressEntryByIndex(i - 1);
+        const ResourceCountType pieceIncome = (next._time - pieceStart) * workers * perWorker;
 
-        if (actionPerformed.isWorker())
+        if (added + pieceIncome >= amount)
         {
-            currentMineralWorkers++;
-        }
-        else if (actionPerformed.isRefinery())
-        {
-            BOSS_ASSERT(currentMineralWorkers > 3, "Not enough mineral workers");
-            currentMineralWorkers -= 3; currentGasWorkers += 3;
+            break;
         }
 
-        // update the last action
-        lastActionFinishFrame = _units.getFinishTimeByIndex(progressIndex);
+        added       += pieceIncome;
+        workers     += gas ? next._gasWorkers : next._mineralWorkers;
+        pieceStart   = next._time;
     }
 
-    // if we still haven't added enough minerals, add more time
-    if (addedGas < difference)
-    {
-		BOSS_ASSERT(currentGasWorkers > 0, "Shouldn't have 0 gas workers");
-		FrameCountType finalTimeToAdd;
-		if (currentGasWorkers != 0)
-		{
-			finalTimeToAdd = (difference - addedGas) / (currentGasWorkers * Constants::GPWPF);
-		}
-		else
-		{
-			finalTimeToAdd = 1000000;
-		}
-        addedGas    += finalTimeToAdd * currentGasWorkers * Constants::GPWPF;
-        addedTime   += finalTimeToAdd;
-
-        // the last operation could have added one frame too little due to integer division so we need to check
-        if (addedGas < difference)
-        {
-            addedTime += 1;
-            addedGas += currentGasWorkers * Constants::GPWPF;
-        }
-    }
-    
-    BOSS_ASSERT(addedGas >= difference, "Gas prediction error");
+    BOSS_ASSERT(workers > 0, "Shouldn't have 0 %s workers", gas ? "gas" : "mineral");
 
-    // for some reason if i don't return +1, i mine 1 less mineral in the interval
-    return _currentFrame + addedTime;
+    // round up, a frame too early would leave us just short
+    return pieceStart + (amount - added + workers * perWorker - 1) / (workers * perWorker);
 }
 
 const FrameCountType GameState::getCurrentFrame() const
@@ -1079,18 +935,6 @@ const std::string GameState::toString() const
     return ss.str();
 }
 
-const std::string GameState::getActionsPerformedString() const
-{
-    std::stringstream ss;
-    ss << std::endl;
-    for (size_t a(0); a<_actionsPerformed.size(); ++a)
-    {
-        ss << (int)_actionsPerformed[a].actionQueuedFrame << " " << (int)_actionsPerformed[a].mineralsWhenQueued << " " << (int)_actionsPerformed[a].gasWhenQueued << " " << _actionsPerformed[a].actionType.getName() << std::endl;
-    }
-
-    return ss.str();
-}
-
 std::string GameState::whyIsNotLegal(const ActionType & action) const
 {
     std::stringstream ss;
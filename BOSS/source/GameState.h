@@ -17,23 +17,11 @@ namespace BOSS
 typedef std::pair<ResourceCountType, ResourceCountType>     ResourcePair;
 typedef std::pair<FrameCountType, FrameCountType>           FramePair;
 
-class ActionPerformed
-{
-public:
-    ActionType          actionType;
-    FrameCountType      actionQueuedFrame;
-    ResourceCountType   mineralsWhenQueued;
-    ResourceCountType   gasWhenQueued;
-
-    ActionPerformed()
-        : actionQueuedFrame(0)
-        , mineralsWhenQueued(0)
-        , gasWhenQueued(0)
-    {
-    
-    }
-};
+// actions finished by a doAction or fastForward, at most every action in progress finishes
+typedef Vec<ActionType, Constants::MAX_PROGRESS>            FinishedActions;
 
+// fixed size and trivially copyable so searches can copy states without allocating, the actions
+// that led to a state are kept by whoever performs them, searches keep them in their BuildOrder
 class GameState 
 {
     UnitData                    _units;  
@@ -48,8 +36,6 @@ class GameState
     ResourceCountType           _minerals; 			        // current mineral count
     ResourceCountType           _gas;						// current gas count
 
-    std::vector<ActionPerformed>   _actionsPerformed;
-
     const FrameCountType        raceSpecificWhenReady(const ActionType & a) const;
     void                        fixZergUnitMasks();
     
@@ -59,6 +45,7 @@ class GameState
     //const FrameCountType        whenConstructedBuildingReady(const ActionType & builder)                const;
     const FrameCountType        whenMineralsReady(const ActionType & action)                            const;
     const FrameCountType        whenGasReady(const ActionType & action)                                 const;
+    const FrameCountType        whenIncomeReaches(const ResourceCountType amount, const bool gas)       const;
     const FrameCountType        whenWorkerReady(const ActionType & action)                              const;
 
 public: 
@@ -71,8 +58,8 @@ public:
     GameState(BWAPI::GameWrapper & game, BWAPI::PlayerInterface * player, const std::vector<BWAPI::UnitType> & buildingsQueued);
 #endif
 
-	std::vector<ActionType>     doAction(const ActionType & action);
-    std::vector<ActionType>     fastForward(const FrameCountType toFrame) ;
+    void                        doAction(const ActionType & action, FinishedActions * finished = nullptr);
+    void                        fastForward(const FrameCountType toFrame, FinishedActions * finished = nullptr);
     void                        finishNextActionInProgress();
 
     const FrameCountType        getCurrentFrame()                                                       const;
@@ -103,7 +90,6 @@ public:
     const ResourceCountType     getFinishTimeGas()              const;
 
     const std::string           toString()                      const;
-    const std::string           getActionsPerformedString()     const;
     const BuildingData &        getBuildingData()               const;
     const HatcheryData &        getHatcheryData()               const;
 
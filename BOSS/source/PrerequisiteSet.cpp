@@ -2,69 +2,67 @@
 
 using namespace BOSS;
 
-ActionCountPair::ActionCountPair()
-    : _count(0)
+PrerequisiteSet::PrerequisiteSet()
 {
-
+    std::fill(_counts, _counts + Constants::MAX_ACTION_TYPES, 0);
 }
 
-ActionCountPair::ActionCountPair(const ActionType & action, const UnitCountType count)
-    : _action(action)
-    , _count(count)
+const size_t PrerequisiteSet::size() const
 {
+    return _actions.size();
 }
 
-const ActionType & ActionCountPair::getAction() const
+const bool PrerequisiteSet::isEmpty() const
 {
-    return _action;
+    return _actions.isEmpty();
 }
 
-const UnitCountType & ActionCountPair::getCount() const
+const bool PrerequisiteSet::contains(const ActionType & action) const
 {
-    return _count;       
+    return _actions.contains(action);
 }
 
-PrerequisiteSet::PrerequisiteSet()
+ActionType PrerequisiteSet::getActionType(const UnitCountType index) const
 {
-
+    return _actions[index];
 }
 
-const size_t PrerequisiteSet::size() const
+const UnitCountType & PrerequisiteSet::getActionTypeCount(const UnitCountType index) const
 {
-    return _actionCounts.size();
+    return _counts[getActionType(index).ID()];
 }
 
-const bool PrerequisiteSet::isEmpty() const
+const UnitCountType & PrerequisiteSet::getCount(const ActionType & action) const
 {
-    return size() == 0;
+    return _counts[action.ID()];
 }
 
-const bool PrerequisiteSet::contains(const ActionType & action) const
+const ActionSet & PrerequisiteSet::getActionSet() const
 {
-    for (size_t i(0); i<_actionCounts.size(); ++i)
-    {
-        if (getActionType(i) == action)
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return _actions;
 }
 
-const ActionType & PrerequisiteSet::getActionType(const UnitCountType index) const
+const ActionSet & PrerequisiteSet::getMultiples() const
 {
-    return _actionCounts[index].getAction();
+    return _multiples;
 }
 
-const UnitCountType & PrerequisiteSet::getActionTypeCount(const UnitCountType index) const
-{
-    return _actionCounts[index].getCount();
-}
-    
+// adding an action that is already in the set keeps the larger count
 void PrerequisiteSet::add(const ActionType & action, const UnitCountType count)
 {
-    _actionCounts.push_back(ActionCountPair(action, count));
+    const size_t id = action.ID();
+
+    if (!_actions.contains(action) || count > _counts[id])
+    {
+        _counts[id] = count;
+    }
+
+    _actions.add(action);
+
+    if (_counts[id] > 1)
+    {
+        _multiples.add(action);
+    }
 }
 
 void PrerequisiteSet::addUnique(const ActionType & action, const UnitCountType count)
@@ -85,37 +83,24 @@ void PrerequisiteSet::addUnique(const PrerequisiteSet & set)
 
 void PrerequisiteSet::remove(const ActionType & action)
 {
-    for (size_t i(0); i<_actionCounts.size(); ++i)
-    {
-        if (_actionCounts[i].getAction() == action)
-        {
-            _actionCounts.remove(i);
-            return;
-        }
-    }
+    _actions.remove(action);
+    _multiples.remove(action);
 }
 
 void PrerequisiteSet::remove(const PrerequisiteSet & set)
 {
-    if (isEmpty())
-    {
-        return;
-    }
-
-    for (size_t i(0); i < set.size(); ++i)
-    {
-        remove(set.getActionType(i));
-    }
+    _actions.remove(set._actions);
+    _multiples.remove(set._actions);
 }
 
 const std::string PrerequisiteSet::toString() const
 {
     std::stringstream ss;
-    
+
     for (size_t i(0); i<size(); ++i)
     {
         ss << "    Prereq:   " << (int)getActionTypeCount(i) << " " << getActionType(i).getName() << "\n";
     }
 
     return ss.str();
-}
\ No newline at end of file
+}
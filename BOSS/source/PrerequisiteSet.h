@@ -4,29 +4,19 @@
 #include "Constants.h"
 #include "Array.hpp"
 #include "ActionType.h"
+#include "ActionSet.h"
 
 namespace BOSS
 {
 
-class ActionCountPair
-{
-    ActionType      _action;
-    UnitCountType   _count;
-
-public:
-
-    ActionCountPair();
-
-    ActionCountPair(const ActionType & action, const UnitCountType count);
-
-    const ActionType & getAction() const;
-
-    const UnitCountType & getCount() const;
-};
-
+// action types with a required count, the types are an ActionSet and the counts a side table
+// indexed by action ID. the actions needing more than one are kept as their own set so a
+// prerequisite check only has to look at counts for those
 class PrerequisiteSet
 {
-	Vec<ActionCountPair, Constants::MAX_ACTION_TYPES> _actionCounts;
+    ActionSet       _actions;
+    ActionSet       _multiples;
+    UnitCountType   _counts[Constants::MAX_ACTION_TYPES];
 
 public:
 
@@ -35,9 +25,12 @@ public:
     const size_t size() const;
     const bool isEmpty() const;
     const bool contains(const ActionType & action) const;
-    const ActionType & getActionType(const UnitCountType index) const;
+    ActionType getActionType(const UnitCountType index) const;
     const UnitCountType & getActionTypeCount(const UnitCountType index) const;
-    
+    const UnitCountType & getCount(const ActionType & action) const;
+    const ActionSet & getActionSet() const;
+    const ActionSet & getMultiples() const;
+
     void add(const ActionType & action, const UnitCountType count = 1);
     void addUnique(const ActionType & action, const UnitCountType count = 1);
     void addUnique(const PrerequisiteSet & set);
@@ -47,4 +40,4 @@ public:
     const std::string toString() const;
 };
 
-}
\ No newline at end of file
+}
@@ -38,6 +38,7 @@ const FrameCountType UnitData::getWhenBuildingCanBuild(const ActionType & action
 void UnitData::addCompletedBuilding(const ActionType & action, const FrameCountType timeUntilFree, const ActionType & constructing, const ActionType & addon, int numLarva)
 {
     _numUnits[action.ID()] += action.numProduced();
+    updateOwned(action);
 
     _maxSupply += action.supplyProvided();
 
@@ -67,6 +68,7 @@ void UnitData::addCompletedAction(const ActionType & action, bool wasBuilt)
     const static ActionType Hive = ActionTypes::GetActionType("Zerg_Hive");
 
     _numUnits[action.ID()] += wasBuilt ? action.numProduced() : 1;
+    updateOwned(action);
 
     if (wasBuilt)
     {
@@ -116,6 +118,7 @@ void UnitData::removeCompletedAction(const ActionType & action)
 	const static ActionType Hive = ActionTypes::GetActionType("Zerg_Hive");
 
 	_numUnits[action.ID()] -= action.numProduced();
+	updateOwned(action);
 
 
 		// a lair or hive from a hatchery don't produce additional supply
@@ -167,6 +170,7 @@ void UnitData::addActionInProgress(const ActionType & action, const FrameCountTy
 
 	// add it to the actions in progress
 	_progress.addAction(action, finishTime);
+    updateOwned(action);
     
     if (!action.isMorphed())
     {
@@ -239,6 +243,7 @@ void UnitData::morphUnit(const ActionType & from, const ActionType & to, const F
 {
     BOSS_ASSERT(getNumCompleted(from) > 0, "Must have the unit type to morph it");
     _numUnits[from.ID()]--;
+    updateOwned(from);
     _currentSupply -= from.supplyRequired();
 
     if (from.isWorker())
@@ -275,6 +280,7 @@ ActionType UnitData::finishNextActionInProgress()
 			
 	// pop it from the progress vector
 	_progress.popNextAction();
+	updateOwned(action);
 			
 	if (getRace() == Races::Terran)
 	{
@@ -313,6 +319,18 @@ const UnitCountType UnitData::getNumTotal(const ActionType & action) const
     return _numUnits[action.ID()] + (_progress.numInProgress(action) * action.numProduced());
 }
 
+void UnitData::updateOwned(const ActionType & action)
+{
+    if (getNumTotal(action) > 0)
+    {
+        _owned.add(action);
+    }
+    else
+    {
+        _owned.remove(action);
+    }
+}
+
 const bool UnitData::hasPrerequisites(const PrerequisiteSet & required) const
 {
     static const ActionType & Hatchery      = ActionTypes::GetActionType("Zerg_Hatchery");
@@ -321,10 +339,42 @@ const bool UnitData::hasPrerequisites(const PrerequisiteSet & required) const
     static const ActionType & Spire         = ActionTypes::GetActionType("Zerg_Spire");
     static const ActionType & GreaterSpire  = ActionTypes::GetActionType("Zerg_Greater_Spire");
 
-    for (size_t a(0); a<required.size(); ++a)
+    // every required type has to be owned, morphed zerg buildings count as what they morphed from
+    if (_race == Races::Zerg)
     {
-        const ActionType & type = required.getActionType(a);
-        const size_t & req = required.getActionTypeCount(a);
+        ActionSet owned(_owned);
+
+        if (owned.contains(Lair) || owned.contains(Hive))
+        {
+            owned.add(Hatchery);
+        }
+
+        if (owned.contains(Hive))
+        {
+            owned.add(Lair);
+        }
+
+        if (owned.contains(GreaterSpire))
+        {
+            owned.add(Spire);
+        }
+
+        if (!owned.contains(required.getActionSet()))
+        {
+            return false;
+        }
+    }
+    else if (!_owned.contains(required.getActionSet()))
+    {
+        return false;
+    }
+
+    // only the types needed more than once have to have their counts checked
+    const ActionSet & multiples = required.getMultiples();
+    for (size_t a(0); a<multiples.size(); ++a)
+    {
+        const ActionType & type = multiples[a];
+        const size_t req = required.getCount(type);
         size_t have = getNumTotal(type);
 
         // special check for zerg moprhed buildings
@@ -377,6 +427,11 @@ const ActionType & UnitData::getActionInProgressByIndex(const UnitCountType & in
     return _progress.getAction(index);
 }
 
+const ActionInProgress & UnitData::getActionInProgressEntryByIndex(const UnitCountType & index) const
+{
+    return _progress.getActionInProgress(index);
+}
+
 const FrameCountType UnitData::getActionInProgressFinishTimeByIndex(const UnitCountType & index) const
 {
     return _progress.getTime(index);
@@ -6,6 +6,7 @@
 #include "ActionType.h"
 #include "ActionInProgress.h"
 #include "HatcheryData.h"
+#include "ActionSet.h"
 
 namespace BOSS
 {
@@ -27,6 +28,10 @@ class UnitData
     ActionsInProgress	                _progress;					
     BuildingData		                _buildings;
 
+    ActionSet                           _owned;                     // types we have at least one of, completed or in progress
+
+    void                    updateOwned(const ActionType & action);
+
 public:
 
     UnitData(const RaceID race);
@@ -50,6 +55,7 @@ public:
     const UnitCountType     getSupplyInProgress() const;
 
     const ActionType &      getActionInProgressByIndex(const UnitCountType & index) const;
+    const ActionInProgress & getActionInProgressEntryByIndex(const UnitCountType & index) const;
     const FrameCountType    getActionInProgressFinishTimeByIndex(const UnitCountType & index) const;
 
     const FrameCountType    getNextBuildingFinishTime() const;
@@ -261,6 +261,11 @@ PlayerPtr AIParameters::parsePlayer(const size_t & player, const std::string & p
         params.setTimeLimit(playerValue["TimeLimit"].GetInt());
         params.setMaxPlayoutTurns(playerValue["MaxPlayoutTurns"].GetInt());
 
+        if (playerValue.HasMember("Threads") && playerValue["Threads"].IsInt())
+        {
+            params.setThreads(playerValue["Threads"].GetInt());
+        }
+
         const rapidjson::Value & portfolio = playerValue["Portfolio"];
 
         SPARCRAFT_ASSERT(portfolio.IsArray() && portfolio.Size() > 0, "PGS Portfolio must be a non-empty Array");
@@ -318,6 +323,38 @@ PlayerPtr AIParameters::parsePlayer(const size_t & player, const std::string & p
             params.setCValue(args["UCTConstant"].GetDouble());
         }
 
+        if (args.HasMember("Threads") && args["Threads"].IsInt())
+        {
+            params.setNumThreads(args["Threads"].GetInt());
+        }
+
+        if (args.HasMember("Parallel") && args["Parallel"].IsString())
+        {
+            const std::string & parallelString = args["Parallel"].GetString();
+            if (parallelString == "Root")
+            {
+                params.setParallelMethod(UCTParallelMethod::RootParallel);
+            }
+            else if (parallelString == "Tree")
+            {
+                params.setParallelMethod(UCTParallelMethod::TreeParallel);
+            }
+            else
+            {
+                SPARCRAFT_ASSERT(false, "Unknown UCT Parallel Method Name: %s", parallelString.c_str());
+            }
+        }
+
+        if (args.HasMember("VirtualLoss") && args["VirtualLoss"].IsInt())
+        {
+            params.setVirtualLoss(args["VirtualLoss"].GetInt());
+        }
+
+        if (args.HasMember("TTSize") && args["TTSize"].IsInt())
+        {
+            params.setTranspositionTableSize(args["TTSize"].GetInt());
+        }
+
         //params.setGraphVizFilename("uct.png");
         
         playerPtr = PlayerPtr(new Player_UCT(player, params));
@@ -24,6 +24,9 @@ void ActionGenerators::GenerateCompassActions(const GameState & state, const siz
 	// so return all units which can move at the same time as the first
 	TimeType firstUnitMoveTime = state.getTimeNextUnitCanAct(player);
 
+    // enemy units within attack range of the current unit
+    std::vector<size_t> enemyUnitsInRange;
+
 	for (size_t unitIndex(0); unitIndex < state.numUnits(player); ++unitIndex)
 	{
 		// unit reference
@@ -44,9 +47,12 @@ void ActionGenerators::GenerateCompassActions(const GameState & state, const siz
 		// generate attack moves
 		if (unit.canAttackNow())
 		{
-			for (size_t u(0); u < state.numUnits(enemyPlayer); ++u)
+            // only enemy units the spatial index finds within range can be attacked
+            state.getUnitIDsInRange(enemyPlayer, unit.currentPosition(state.getTime()), unit.range(), enemyUnitsInRange);
+
+			for (const size_t & enemyUnitID : enemyUnitsInRange)
 			{
-				const Unit & enemyUnit = state.getUnit(enemyPlayer, u);
+				const Unit & enemyUnit = state.getUnitByID(enemyUnitID);
 				bool invisible = false;
 				if (enemyUnit.type().hasPermanentCloak())
 				{
@@ -62,7 +68,7 @@ void ActionGenerators::GenerateCompassActions(const GameState & state, const siz
 						}
 					}
 				}
-				if (!invisible && unit.canAttackTarget(enemyUnit, state.getTime()) && enemyUnit.isAlive())
+				if (!invisible && unit.canTarget(enemyUnit))
 				{
 					moves.add(Action(unit.getID(), player, ActionTypes::ATTACK, enemyUnit.getID()));
                     //moves.add(Action(unitIndex, player, ActionTypes::ATTACK, unit.getID()));
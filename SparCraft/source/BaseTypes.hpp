@@ -8,6 +8,6 @@ namespace SparCraft
     typedef		unsigned char		ChildCountType;
     typedef 	int					TimeType;
     typedef		short				HealthType;
-    typedef		unsigned int		HashType;
+    typedef		unsigned long long	HashType;
     typedef     int                 UCTValue;
 }
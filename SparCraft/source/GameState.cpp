@@ -3,12 +3,15 @@
 #include "Player.h"
 #include "Game.h"
 #include "SparCraftAssert.h"
+#include "Hash.h"
 
 using namespace SparCraft;
 
 GameState::GameState()
 	: _map(NULL)
 	, _currentTime(0)
+    , _hash(Hash::TimeHash(0))
+    , _spatialIndexDirty(false)
 {
     _numMovements[0] = 0;
     _numMovements[1] = 0;
@@ -23,6 +26,9 @@ void GameState::doAction(const Action & action)
 
     SPARCRAFT_ASSERT(ourUnit.firstTimeFree() == getTime(), "Trying to take an action at a different frame than a unit is ready");
 
+    recordUnit(ourUnit);
+    _hash ^= Hash::UnitHash(ourUnit);
+
 	if (action.type() == ActionTypes::ATTACK)
 	{
 		Unit & enemyUnit = _getUnitByID(action.getTargetID());
@@ -33,20 +39,42 @@ void GameState::doAction(const Action & action)
 		// enemy unit takes damage if it is alive
 		if (enemyUnit.isAlive())
 		{				
+            recordUnit(enemyUnit);
+            _hash ^= Hash::UnitHash(enemyUnit);
 			enemyUnit.takeAttack(ourUnit);
+            _unitData.updateUnit(enemyUnit.getID());
 
             // check to see if enemy unit died
 	        if (!enemyUnit.isAlive())
 	        {
 		        // if it died, remove it
-                _unitData.killUnit(enemyUnit.getID());
+                const size_t liveIndex = _unitData.killUnit(enemyUnit.getID());
+
+                if (_undoLog.isEnabled())
+                {
+                    UndoRecord & record = _undoLog.push(UndoTypes::UnitKilled);
+                    record.id = enemyUnit.getID();
+                    record.index = liveIndex;
+                    record.hash = _hash;
+                }
 	        }
+            else
+            {
+                _hash ^= Hash::UnitHash(enemyUnit);
+            }
 		}			    
 	}
 	else if (action.type() == ActionTypes::MOVE)
 	{
 		_numMovements[player]++;
 
+        if (_undoLog.isEnabled())
+        {
+            UndoRecord & record = _undoLog.push(UndoTypes::MovementAdded);
+            record.id = player;
+            record.hash = _hash;
+        }
+
         if (_map.get() == nullptr)
         {
             ourUnit.move(action, getTime());
@@ -75,6 +103,9 @@ void GameState::doAction(const Action & action)
         SPARCRAFT_ASSERT(false, "Invalid Action Type: %d", (int)action.type());
     }
 
+    _hash ^= Hash::UnitHash(ourUnit);
+    _unitData.updateUnit(ourUnit.getID());
+
     SPARCRAFT_ASSERT(ourUnit.firstTimeFree() > gameTime, "Action did not increase unit cooldown, Game Time is: %d\n\n%s", gameTime, ourUnit.debugString().c_str());
 }
 
@@ -153,7 +184,10 @@ void GameState::addUnit(const Unit & u)
         std::cerr << "Skipping un-supported unit type: " << u.type().getName() << "\n";
     }
 
-    _unitData.addUnit(u);
+    _hash ^= Hash::UnitHash(_unitData.addUnit(u));
+
+    // a state is set up by adding its units one by one, so the index is built once when it is first queried
+    _spatialIndexDirty = true;
 }
 
 Unit & GameState::_getUnit(const size_t & player, const size_t & unitIndex)
@@ -226,18 +260,16 @@ size_t GameState::whoCanMove() const
 
 TimeType GameState::getTimeNextUnitCanAct(const size_t & player) const
 {
-    int minTime = std::numeric_limits<int>::max();
-    for (size_t u(0); u < numUnits(player); ++u)
-    {
-        minTime = std::min(getUnit(player, u).firstTimeFree(), minTime);
-    }
-
-    return minTime;
+    return _unitData.getTimeNextUnitCanAct(player);
 }
 
 void GameState::updateGameTime()
 {
+    recordTime();
+    _hash ^= Hash::TimeHash(_currentTime);
     _currentTime = std::min(getTimeNextUnitCanAct(0), getTimeNextUnitCanAct(1));
+    _hash ^= Hash::TimeHash(_currentTime);
+    _spatialIndexDirty = true;
 }
 
 void GameState::setMap(std::shared_ptr<Map> map)
@@ -268,7 +300,11 @@ bool GameState::bothCanMove() const
 
 void GameState::setTime(const TimeType & time)
 {
+    recordTime();
+    _hash ^= Hash::TimeHash(_currentTime);
 	_currentTime = time;
+    _hash ^= Hash::TimeHash(_currentTime);
+    _spatialIndexDirty = true;
 }
 
 size_t GameState::getNumMovements(const size_t & player) const
@@ -281,6 +317,12 @@ TimeType GameState::getTime() const
 	return _currentTime;
 }
 
+// zobrist hash of the live units and the game time, states reached by different move orders hash alike
+const HashType & GameState::getHash() const
+{
+    return _hash;
+}
+
 // detect if there is a deadlock, such that no team can possibly win
 bool GameState::gameOver() const
 {
@@ -330,7 +372,106 @@ std::shared_ptr<Map> GameState::getMap() const
 	return _map;
 }
 
+// units keep their current position while actions are done at a given time, so the spatial index
+// only goes out of date when the game time changes or units are added, and is rebuilt by the next query
+void GameState::updateSpatialIndex() const
+{
+    for (size_t p(0); p < Players::Num_Players; ++p)
+    {
+        _spatialIndex[p].build(_unitData, p, _currentTime);
+    }
+
+    _spatialIndexDirty = false;
+}
+
+// IDs of the given player's live units within range of pos at the current game time, sorted by unit ID
+void GameState::getUnitIDsInRange(const size_t & player, const Position & pos, const int & range, std::vector<size_t> & unitIDs) const
+{
+    SPARCRAFT_ASSERT(player < Players::Num_Players, "Player exceeds capacity: player=%d", player);
+
+    if (_spatialIndexDirty)
+    {
+        updateSpatialIndex();
+    }
+
+    _spatialIndex[player].getUnitIDsInRange(pos, range, unitIDs);
+
+    // units killed at the current time are still in the index
+    unitIDs.erase(std::remove_if(unitIDs.begin(), unitIDs.end(), [this](const size_t & id) { return !getUnitByID(id).isAlive(); }), unitIDs.end());
+}
+
 const std::vector<Unit> & GameState::getAllUnits() const
 {
     return _unitData.getAllUnits();
+}
+
+void GameState::recordUnit(const Unit & unit)
+{
+    if (_undoLog.isEnabled())
+    {
+        UndoRecord & record = _undoLog.push(UndoTypes::UnitChanged);
+        record.id = unit.getID();
+        record.hash = _hash;
+        record.unit = unit;
+    }
+}
+
+void GameState::recordTime()
+{
+    if (_undoLog.isEnabled())
+    {
+        UndoRecord & record = _undoLog.push(UndoTypes::TimeChanged);
+        record.time = _currentTime;
+        record.hash = _hash;
+    }
+}
+
+void GameState::setUndoEnabled(const bool enabled)
+{
+    _undoLog.setEnabled(enabled);
+}
+
+size_t GameState::getUndoMark() const
+{
+    return _undoLog.size();
+}
+
+// revert the logged changes newest first until the log is back at the mark
+void GameState::undo(const size_t & mark)
+{
+    SPARCRAFT_ASSERT(_undoLog.isEnabled(), "Undo called on a GameState without an undo log");
+    SPARCRAFT_ASSERT(mark <= _undoLog.size(), "Undo mark is past the end of the undo log: mark=%d, size=%d", mark, _undoLog.size());
+
+    bool timeChanged = false;
+
+    while (_undoLog.size() > mark)
+    {
+        const UndoRecord & record = _undoLog.pop();
+        _hash = record.hash;
+
+        if (record.type == UndoTypes::UnitChanged)
+        {
+            _unitData.getUnitByID(record.id) = record.unit;
+            _unitData.updateUnit(record.id);
+        }
+        else if (record.type == UndoTypes::UnitKilled)
+        {
+            _unitData.reviveUnit(record.id, record.index);
+        }
+        else if (record.type == UndoTypes::TimeChanged)
+        {
+            _currentTime = record.time;
+            timeChanged = true;
+        }
+        else if (record.type == UndoTypes::MovementAdded)
+        {
+            _numMovements[record.id]--;
+        }
+    }
+
+    // unit positions only differ from the indexed ones if the time went back
+    if (timeChanged)
+    {
+        _spatialIndexDirty = true;
+    }
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "Unit.h"
 #include "GraphViz.hpp"
 #include "GameStateUnitData.h"
+#include "GameStateUndoLog.hpp"
+#include "GameStateSpatialIndex.h"
 
 
 #include <memory>
@@ -23,8 +25,16 @@ class GameState
 
     size_t                  _numMovements[2];
     TimeType                _currentTime;
+    HashType                _hash;                  // kept up to date by every change, see Hash.h
+
+    GameStateUndoLog        _undoLog;
+    mutable GameStateSpatialIndex _spatialIndex[2];
+    mutable bool            _spatialIndexDirty;     // units or the time changed since the last build, rebuilt by the next query
 
     void                    doAction(const Action & theMove);
+    void                    recordUnit(const Unit & unit);
+    void                    recordTime();
+    void                    updateSpatialIndex() const;
 
     Unit &                  _getUnitByID(const size_t & unitID);
     Unit &                  _getUnit(const size_t & player,const size_t & unitIndex);
@@ -49,11 +59,15 @@ public:
     const Unit &            getUnit(const size_t & player, const size_t & unitIndex)                const;
     const std::vector<Unit> & getAllUnits()                                                         const;
     const std::vector<size_t> & getUnitIDs(const size_t & player)                                   const;
+    // rebuilds the spatial index if it is out of date, so a state must not be queried from several threads at once,
+    // the parallel searches each query their own copy of the state
+    void                    getUnitIDsInRange(const size_t & player, const Position & pos, const int & range, std::vector<size_t> & unitIDs) const;
 
     // game time functions
     void                    setTime(const TimeType & time);
     TimeType                getTime()                                                               const;
     TimeType                getTimeNextUnitCanAct(const size_t & player)                            const;
+    const HashType &        getHash()                                                               const;
 
     // move related functions
     void                    doMove(const Move & moves);
@@ -62,6 +76,11 @@ public:
     size_t                  whoCanMove()                                                            const;
     bool                    bothCanMove()                                                           const;
 
+    // undo log functions, undo(mark) reverts every change made since getUndoMark() returned mark
+    void                    setUndoEnabled(const bool enabled);
+    size_t                  getUndoMark()                                                           const;
+    void                    undo(const size_t & mark);
+
     // map-related functions
     void                    setMap(std::shared_ptr<Map> map);
     std::shared_ptr<Map>    getMap()                                                                const;
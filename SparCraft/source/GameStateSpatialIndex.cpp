@@ -0,0 +1,134 @@
+#include "GameStateSpatialIndex.h"
+#include <algorithm>
+#include <limits>
+
+using namespace SparCraft;
+
+const int Min_Cell_Size     = 128;  // smallest cell edge in pixels, about the attack range of most units
+const int Max_Cells_Per_Unit = 4;   // cells grow when units are spread out so a build stays linear in units
+
+GameStateSpatialIndex::GameStateSpatialIndex()
+    : _cellSize (Min_Cell_Size)
+    , _originX  (0)
+    , _originY  (0)
+    , _cols     (0)
+    , _rows     (0)
+{
+
+}
+
+void GameStateSpatialIndex::build(const GameStateUnitData & unitData, const size_t & player, const TimeType & gameTime)
+{
+    const std::vector<size_t> & unitIDs = unitData.getUnitIDs(player);
+    const size_t numUnits = unitIDs.size();
+
+    _cellUnitIDs.resize(numUnits);
+    _cellUnitPos.resize(numUnits);
+    _unitPos.resize(numUnits);
+
+    if (numUnits == 0)
+    {
+        _cols = 0;
+        _rows = 0;
+        _cellStart.assign(1, 0);
+        return;
+    }
+
+    int minX = std::numeric_limits<int>::max(), maxX = std::numeric_limits<int>::lowest();
+    int minY = std::numeric_limits<int>::max(), maxY = std::numeric_limits<int>::lowest();
+
+    for (size_t u(0); u < numUnits; ++u)
+    {
+        _unitPos[u] = unitData.getUnitByID(unitIDs[u]).currentPosition(gameTime);
+
+        minX = std::min(minX, _unitPos[u].x());
+        maxX = std::max(maxX, _unitPos[u].x());
+        minY = std::min(minY, _unitPos[u].y());
+        maxY = std::max(maxY, _unitPos[u].y());
+    }
+
+    const size_t maxCells = Max_Cells_Per_Unit * numUnits;
+
+    _cellSize = Min_Cell_Size;
+    while ((size_t)((maxX - minX) / _cellSize + 1) * (size_t)((maxY - minY) / _cellSize + 1) > maxCells)
+    {
+        _cellSize *= 2;
+    }
+
+    _originX = minX;
+    _originY = minY;
+    _cols = (maxX - minX) / _cellSize + 1;
+    _rows = (maxY - minY) / _cellSize + 1;
+
+    // counting sort of the live units into their cells, which keeps each cell in unit ID order
+    _cellStart.assign(_cols * _rows + 1, 0);
+
+    for (size_t u(0); u < numUnits; ++u)
+    {
+        const int cell = getCellCoord(_unitPos[u].y(), _originY, _rows) * _cols + getCellCoord(_unitPos[u].x(), _originX, _cols);
+        _cellStart[cell]++;
+    }
+
+    // running totals, so _cellStart[c] is where cell c ends until the units are placed below
+    for (size_t c(1); c < _cellStart.size() - 1; ++c)
+    {
+        _cellStart[c] += _cellStart[c - 1];
+    }
+
+    _cellStart.back() = (int)numUnits;
+
+    for (size_t u(numUnits); u > 0; --u)
+    {
+        const Position & pos = _unitPos[u - 1];
+        const int cell = getCellCoord(pos.y(), _originY, _rows) * _cols + getCellCoord(pos.x(), _originX, _cols);
+        const int index = --_cellStart[cell];
+
+        _cellUnitIDs[index] = unitIDs[u - 1];
+        _cellUnitPos[index] = pos;
+    }
+}
+
+// returns the grid row or column holding a coordinate, clamped to the grid
+int GameStateSpatialIndex::getCellCoord(const int & value, const int & origin, const int & cells) const
+{
+    if (value < origin)
+    {
+        return 0;
+    }
+
+    return std::min((value - origin) / _cellSize, cells - 1);
+}
+
+void GameStateSpatialIndex::getUnitIDsInRange(const Position & pos, const int & range, std::vector<size_t> & unitIDs) const
+{
+    unitIDs.clear();
+
+    if (_cols == 0)
+    {
+        return;
+    }
+
+    const int colMin = getCellCoord(pos.x() - range, _originX, _cols);
+    const int colMax = getCellCoord(pos.x() + range, _originX, _cols);
+    const int rowMin = getCellCoord(pos.y() - range, _originY, _rows);
+    const int rowMax = getCellCoord(pos.y() + range, _originY, _rows);
+    const int rangeSq = range * range;
+
+    for (int row(rowMin); row <= rowMax; ++row)
+    {
+        for (int col(colMin); col <= colMax; ++col)
+        {
+            const int cell = row * _cols + col;
+
+            for (int i(_cellStart[cell]); i < _cellStart[cell + 1]; ++i)
+            {
+                if (_cellUnitPos[i].getDistanceSq(pos) <= rangeSq)
+                {
+                    unitIDs.push_back(_cellUnitIDs[i]);
+                }
+            }
+        }
+    }
+
+    std::sort(unitIDs.begin(), unitIDs.end());
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Common.h"
+#include "Position.hpp"
+#include "GameStateUnitData.h"
+
+namespace SparCraft
+{
+
+// uniform grid over the positions one player's live units have at the current game time
+// units only change position at the current time when the game time changes, so GameState rebuilds
+// the grid whenever its time changes and the grid stays exact while actions are applied at that time
+// cells are stored compressed (counting sort into one array) so copying a state copies a few flat vectors
+class GameStateSpatialIndex
+{
+    int                     _cellSize;
+    int                     _originX;
+    int                     _originY;
+    int                     _cols;
+    int                     _rows;
+
+    std::vector<int>        _cellStart;         // _cellStart[c] .. _cellStart[c+1] index the units of cell c
+    std::vector<size_t>     _cellUnitIDs;       // unit IDs sorted by cell
+    std::vector<Position>   _cellUnitPos;       // position of each unit in _cellUnitIDs at the indexed time
+    std::vector<Position>   _unitPos;           // build scratch, position of each live unit in live order
+
+    int                     getCellCoord(const int & value, const int & origin, const int & cells) const;
+
+public:
+
+    GameStateSpatialIndex();
+
+    void                    build(const GameStateUnitData & unitData, const size_t & player, const TimeType & gameTime);
+
+    // fills unitIDs with the IDs of indexed units within distance range of pos, sorted by unit ID
+    void                    getUnitIDsInRange(const Position & pos, const int & range, std::vector<size_t> & unitIDs) const;
+};
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Common.h"
+#include "Unit.h"
+
+namespace SparCraft
+{
+
+namespace UndoTypes
+{
+    enum { UnitChanged, UnitKilled, TimeChanged, MovementAdded };
+}
+
+// a single change made to a GameState, holding what is needed to reverse it
+class UndoRecord
+{
+public:
+
+    size_t      type;
+    size_t      id;         // unit ID, or player ID for MovementAdded
+    size_t      index;      // index of a killed unit in its player's live unit list
+    TimeType    time;       // game time before a TimeChanged
+    Unit        unit;       // unit before a UnitChanged
+    HashType    hash;       // state hash before the change
+
+    UndoRecord()
+        : type  (UndoTypes::UnitChanged)
+        , id    (0)
+        , index (0)
+        , time  (0)
+        , hash  (0)
+    {
+    }
+};
+
+// the undo log of a GameState, searches enable it on a working state and roll it back to a mark
+// instead of copying the state for every traversal
+// copies of a state never inherit the log, so playouts started from a logging state don't record
+class GameStateUndoLog
+{
+    bool                        _enabled;
+    std::vector<UndoRecord>     _records;
+    size_t                      _size;          // records in use, the vector only grows so records are reused
+
+public:
+
+    GameStateUndoLog()
+        : _enabled  (false)
+        , _size     (0)
+    {
+    }
+
+    GameStateUndoLog(const GameStateUndoLog & log)
+        : _enabled  (false)
+        , _size     (0)
+    {
+    }
+
+    GameStateUndoLog & operator = (const GameStateUndoLog & log)
+    {
+        _enabled = false;
+        _size = 0;
+        return *this;
+    }
+
+    const bool      isEnabled()     const   { return _enabled; }
+    const size_t &  size()          const   { return _size; }
+    void            setEnabled(const bool enabled) { _enabled = enabled; _size = 0; }
+
+    UndoRecord & push(const size_t & type)
+    {
+        if (_size == _records.size())
+        {
+            _records.push_back(UndoRecord());
+        }
+
+        UndoRecord & record = _records[_size++];
+        record.type = type;
+        return record;
+    }
+
+    const UndoRecord & pop()
+    {
+        SPARCRAFT_ASSERT(_size > 0, "Popping an empty undo log");
+
+        return _records[--_size];
+    }
+};
+
+}
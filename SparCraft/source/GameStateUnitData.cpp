@@ -1,4 +1,5 @@
 #include "GameStateUnitData.h"
+#include <limits>
 
 using namespace SparCraft;
 
@@ -52,10 +53,118 @@ Unit & GameStateUnitData::addUnit(const Unit & unit)
     Unit & unitInVector = _allUnits.back();
 
     _liveUnitIDs[unitInVector.getPlayerID()].push_back(unitInVector.getID());
+    _readyHeapIndex.push_back(-1);
+
+    heapInsert(unitInVector.getID());
     
     return unitInVector;
 }
 
+void GameStateUnitData::updateUnit(const size_t & unitID)
+{
+    SPARCRAFT_ASSERT(unitID < _allUnits.size(), "Unit id exceeds capacity: id=%d, capacity=%d", unitID, _allUnits.size());
+
+    if (_readyHeapIndex[unitID] >= 0)
+    {
+        heapFix(_allUnits[unitID].getPlayerID(), _readyHeapIndex[unitID]);
+    }
+}
+
+// the earliest time a live unit of the player is free, or the max time if the player has no units
+TimeType GameStateUnitData::getTimeNextUnitCanAct(const size_t & player) const
+{
+    SPARCRAFT_ASSERT(player < 2, "Player exceeds capacity: player=%d", player);
+
+    if (_readyHeap[player].empty())
+    {
+        return std::numeric_limits<TimeType>::max();
+    }
+
+    return readyTime(_readyHeap[player][0]);
+}
+
+TimeType GameStateUnitData::readyTime(const size_t & unitID) const
+{
+    return _allUnits[unitID].firstTimeFree();
+}
+
+void GameStateUnitData::heapInsert(const size_t & unitID)
+{
+    const size_t player = getUnitByID(unitID).getPlayerID();
+
+    SPARCRAFT_ASSERT(_readyHeapIndex[unitID] < 0, "Unit is already in the ready heap: id=%d", unitID);
+
+    _readyHeap[player].push_back(unitID);
+    _readyHeapIndex[unitID] = (int)(_readyHeap[player].size() - 1);
+    heapFix(player, _readyHeap[player].size() - 1);
+}
+
+// the last unit of the heap takes the removed unit's place and is moved to where it belongs
+void GameStateUnitData::heapRemove(const size_t & unitID)
+{
+    const size_t player = getUnitByID(unitID).getPlayerID();
+    std::vector<size_t> & heap = _readyHeap[player];
+
+    SPARCRAFT_ASSERT(_readyHeapIndex[unitID] >= 0, "Unit is not in the ready heap: id=%d", unitID);
+
+    const size_t index = (size_t)_readyHeapIndex[unitID];
+    const size_t lastID = heap.back();
+
+    heap.pop_back();
+    _readyHeapIndex[unitID] = -1;
+
+    if (index < heap.size())
+    {
+        heap[index] = lastID;
+        _readyHeapIndex[lastID] = (int)index;
+        heapFix(player, index);
+    }
+}
+
+// restore the heap order after the ready time of the unit at index changed, in either direction
+void GameStateUnitData::heapFix(const size_t & player, size_t index)
+{
+    std::vector<size_t> & heap = _readyHeap[player];
+    const size_t unitID = heap[index];
+    const TimeType time = readyTime(unitID);
+
+    // sift up while the parent is free later
+    while (index > 0 && readyTime(heap[(index - 1) / 2]) > time)
+    {
+        heap[index] = heap[(index - 1) / 2];
+        _readyHeapIndex[heap[index]] = (int)index;
+        index = (index - 1) / 2;
+    }
+
+    // sift down while a child is free earlier
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+
+        if (child >= heap.size())
+        {
+            break;
+        }
+
+        if (child + 1 < heap.size() && readyTime(heap[child + 1]) < readyTime(heap[child]))
+        {
+            ++child;
+        }
+
+        if (readyTime(heap[child]) >= time)
+        {
+            break;
+        }
+
+        heap[index] = heap[child];
+        _readyHeapIndex[heap[index]] = (int)index;
+        index = child;
+    }
+
+    heap[index] = unitID;
+    _readyHeapIndex[unitID] = (int)index;
+}
+
 void GameStateUnitData::removeUnit(const size_t & player, const size_t & unitIndex)
 {
     SPARCRAFT_ASSERT(player < Players::Num_Players, "player exceeds capacity: player=%d, total players=%d", player, Players::Num_Players);    
@@ -64,7 +173,8 @@ void GameStateUnitData::removeUnit(const size_t & player, const size_t & unitInd
     _liveUnitIDs[player].erase(_liveUnitIDs[player].begin() + unitIndex);
 }
 
-void GameStateUnitData::removeUnitByID(const size_t & unitID)
+// returns the index the unit had in its player's live unit list
+size_t GameStateUnitData::removeUnitByID(const size_t & unitID)
 {
     const size_t player = getUnitByID(unitID).getPlayerID();
     const size_t units = numUnits(player);
@@ -74,18 +184,29 @@ void GameStateUnitData::removeUnitByID(const size_t & unitID)
         if (_liveUnitIDs[player][c] == unitID)
         {
             removeUnit(player, c);
-            return;
+            return c;
         }
     }
 
     SPARCRAFT_ASSERT(false, "Tried to remove a Unit that didn't exist: %d", unitID);
+    return units;
 }
 
-void GameStateUnitData::killUnit(const size_t & UnitID)
+size_t GameStateUnitData::killUnit(const size_t & UnitID)
 {
-    Unit & Unit = getUnitByID(UnitID);
+    heapRemove(UnitID);
+    return removeUnitByID(UnitID);
+}
+
+// put a killed unit back at the live list index it was removed from, used to undo a kill
+void GameStateUnitData::reviveUnit(const size_t & unitID, const size_t & liveIndex)
+{
+    const size_t player = getUnitByID(unitID).getPlayerID();
+
+    SPARCRAFT_ASSERT(liveIndex <= numUnits(player), "Revived unit index exceeds live units: index=%d, size=%d", liveIndex, numUnits(player));
 
-    removeUnitByID(UnitID);
+    _liveUnitIDs[player].insert(_liveUnitIDs[player].begin() + liveIndex, unitID);
+    heapInsert(unitID);
 }
 
 const std::vector<size_t> & GameStateUnitData::getUnitIDs(const size_t & player) const
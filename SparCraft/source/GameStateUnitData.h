@@ -9,11 +9,23 @@ namespace SparCraft
 
 class GameStateUnitData 
 {
+    // units stay whole Unit objects rather than per-field arrays, the rest of the engine reads and
+    // changes them through Unit references, and the ready heaps below answer getTimeNextUnitCanAct
     std::vector<Unit>       _allUnits;          // vector where all Unit objects live
     std::vector<size_t>     _liveUnitIDs[2];    // vectors of IDs of live units for each player, ID indexes into _allUnits
+
+    // binary min-heap of each player's live unit IDs keyed by the unit's first free time, kept up to date by
+    // updateUnit, killUnit and reviveUnit so the next time a player can act is read off the top
+    std::vector<size_t>     _readyHeap[2];
+    std::vector<int>        _readyHeapIndex;    // position of each unit ID in its player's heap, -1 if not live
     
     void                    removeUnit(const size_t & player, const size_t & UnitIndex);
-    void                    removeUnitByID(const size_t & unitID);
+    size_t                  removeUnitByID(const size_t & unitID);
+
+    TimeType                readyTime(const size_t & unitID) const;
+    void                    heapInsert(const size_t & unitID);
+    void                    heapRemove(const size_t & unitID);
+    void                    heapFix(const size_t & player, size_t index);
 
 public:
         
@@ -31,7 +43,12 @@ public:
     const std::vector<size_t> & getUnitIDs(const size_t & player) const;
 
     Unit &                  addUnit(const Unit & unit);
-    void                    killUnit(const size_t & unitID);
+    size_t                  killUnit(const size_t & unitID);
+    void                    reviveUnit(const size_t & unitID, const size_t & liveIndex);
+
+    // updateUnit must be called after the action times of a unit returned by a non-const getter change
+    void                    updateUnit(const size_t & unitID);
+    TimeType                getTimeNextUnitCanAct(const size_t & player) const;
 };
 
 }
@@ -0,0 +1,51 @@
+#include "Hash.h"
+
+using namespace SparCraft;
+
+const HashType Unit_Key_Seed = 0x9E3779B97F4A7C15ULL;   // golden ratio increment of splitmix64
+const HashType Time_Key      = 0xC2B2AE3D27D4EB4FULL;   // key the game time is combined with
+
+// splitmix64 finalizer, every input bit affects every output bit
+const HashType Hash::Mix(HashType value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+const HashType Hash::Combine(const HashType & hash, const HashType & value)
+{
+    return Mix(hash ^ (value + Unit_Key_Seed + (hash << 6) + (hash >> 2)));
+}
+
+// hash of everything that decides what a unit does from now on
+// a moving unit's current position depends on where and when its move started, so those are included too
+const HashType Hash::UnitHash(const Unit & unit)
+{
+    HashType hash = Mix((unit.getID() + 1) * Unit_Key_Seed);
+
+    hash = Combine(hash, (HashType)unit.getPlayerID());
+    hash = Combine(hash, (HashType)unit.typeID());
+    hash = Combine(hash, ((HashType)(unsigned int)unit.x() << 32) | (unsigned int)unit.y());
+    hash = Combine(hash, (HashType)(unsigned short)unit.currentHP());
+    hash = Combine(hash, ((HashType)(unsigned int)unit.nextMoveActionTime() << 32) | (unsigned int)unit.nextAttackActionTime());
+    hash = Combine(hash, (HashType)unit.previousAction().type());
+
+    if (unit.previousAction().type() == ActionTypes::MOVE)
+    {
+        const Position & from = unit.previousPosition();
+
+        hash = Combine(hash, ((HashType)(unsigned int)from.x() << 32) | (unsigned int)from.y());
+        hash = Combine(hash, (HashType)(unsigned int)unit.previousActionTime());
+    }
+
+    return hash;
+}
+
+const HashType Hash::TimeHash(const TimeType & time)
+{
+    return Mix(Time_Key ^ (HashType)(unsigned int)time);
+}
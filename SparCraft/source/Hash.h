@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Common.h"
+#include "Unit.h"
+
+namespace SparCraft
+{
+// zobrist hashing of game states
+// a state's hash is the xor of the hash of every live unit and the hash of the game time, so
+// GameState keeps it up to date by xoring out a unit before an action changes it and back in after
+// keys are derived from the unit ID with a fixed mixing function rather than drawn from random tables,
+// so every state, thread and run hashes the same position to the same value
+namespace Hash
+{
+    const HashType Mix(HashType value);
+    const HashType Combine(const HashType & hash, const HashType & value);
+
+    const HashType UnitHash(const Unit & unit);
+    const HashType TimeHash(const TimeType & time);
+}
+}
@@ -7,6 +7,7 @@ PGSParameters::PGSParameters(const size_t & playerID)
     , _iterations(1)
     , _responses(0)
     , _maxPlayoutTurns(0)
+    , _threads(1)
 {
 
 }
@@ -16,6 +17,12 @@ void PGSParameters::setMaxPlayoutTurns(const size_t & turns)
     _maxPlayoutTurns = turns;
 }
 
+// number of threads evaluating the playouts of a unit's scripts in parallel, 0 uses every hardware thread
+void PGSParameters::setThreads(const size_t & threads)
+{
+    _threads = threads;
+}
+
 void PGSParameters::setEnemySeedPlayer(const PlayerPtr & player)
 {
     _enemySeedPlayer = player;
@@ -41,11 +48,34 @@ void PGSParameters::addPortfolioPlayer(const size_t & playerID, const PlayerPtr
     _playerPortfolio[playerID].push_back(player);
 }
 
+// replace the seed and portfolio players with clones of their own, copied parameters otherwise share them
+// and script players keep per-move scratch state, so two searches running at once must not use the same ones
+void PGSParameters::clonePlayers()
+{
+    if (_enemySeedPlayer)
+    {
+        _enemySeedPlayer = _enemySeedPlayer->clone();
+    }
+
+    for (size_t p(0); p < 2; ++p)
+    {
+        for (size_t i(0); i < _playerPortfolio[p].size(); ++i)
+        {
+            _playerPortfolio[p][i] = _playerPortfolio[p][i]->clone();
+        }
+    }
+}
+
 const size_t & PGSParameters::getMaxPlayoutTurns() const
 {
     return _maxPlayoutTurns;
 }
 
+const size_t & PGSParameters::getThreads() const
+{
+    return _threads;
+}
+
 const PlayerPtr & PGSParameters::getEnemySeedPlayer() const
 {
     return _enemySeedPlayer;
@@ -85,6 +115,7 @@ const std::string & PGSParameters::toString()
         ss << "Responses:  " << _responses << "\n";
         ss << "Max PTurns: " << _maxPlayoutTurns << "\n";
         ss << "Time Limit: " << _timeLimit << "\n";
+        ss << "Threads:    " << _threads << "\n";
         ss << "Portfolio:\n";
 
         for (size_t i(0); i < _playerPortfolio[_playerID].size(); ++i)
@@ -14,6 +14,7 @@ class PGSParameters
     size_t                  _responses;
     size_t                  _timeLimit;
     size_t                  _maxPlayoutTurns;
+    size_t                  _threads;
     std::vector<PlayerPtr>  _playerPortfolio[2];
     std::string             _description;
 
@@ -26,7 +27,9 @@ public:
     void setResponses(const size_t & responses);
     void setTimeLimit(const size_t & timeLimit);
     void setMaxPlayoutTurns(const size_t & turns);
+    void setThreads(const size_t & threads);
     void addPortfolioPlayer(const size_t & playerID, const PlayerPtr & player);
+    void clonePlayers();
 
     const PlayerPtr & getEnemySeedPlayer() const;
     const size_t & getPlayer() const;
@@ -34,6 +37,7 @@ public:
     const size_t & getResponses() const;
     const size_t & getTimeLimit() const;
     const size_t & getMaxPlayoutTurns() const;
+    const size_t & getThreads() const;
     const std::vector<PlayerPtr> & getPortfolio(const size_t & playerID) const;
 
     const std::string & toString();
@@ -16,14 +16,26 @@ void Player_PortfolioGreedySearch::getMove(const GameState & state, Move & move)
     move.clear();
 
 	PortfolioGreedySearch pgs(_params);
+    pgs.setThreadPool(_threadPool);
 
 	move = pgs.search(state, _playerID);
+    _threadPool = pgs.getThreadPool();
     stopTimer();
 }
 
+PGSParameters & Player_PortfolioGreedySearch::getParams()
+{
+    return _params;
+}
+
 PlayerPtr Player_PortfolioGreedySearch::clone()
 {
-    return PlayerPtr(new Player_PortfolioGreedySearch(*this));
+    // clones may search concurrently, and a pool runs one batch at a time
+    Player_PortfolioGreedySearch * player = new Player_PortfolioGreedySearch(*this);
+    player->_threadPool.reset();
+    player->_params.clonePlayers();
+
+    return PlayerPtr(player);
 }
 
 const std::string & Player_PortfolioGreedySearch::getDescription()
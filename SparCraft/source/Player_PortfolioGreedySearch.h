@@ -4,6 +4,7 @@
 #include "Player.h"
 #include "PortfolioGreedySearch.h"
 #include "PGSParameters.h"
+#include "ThreadPool.hpp"
 
 namespace SparCraft
 {
@@ -11,11 +12,13 @@ class Player_PortfolioGreedySearch : public Player
 {
 	PGSParameters _params;
     bool _computedDescription;
+    std::shared_ptr<ThreadPool> _threadPool;    // kept between moves so the search threads are only started once
 
 public:
 
     Player_PortfolioGreedySearch (const size_t & playerID, const PGSParameters & params);
 	void getMove(const GameState & state, Move & move);
+    PGSParameters & getParams();
     virtual const std::string & getDescription();
     virtual PlayerPtr clone();
 };
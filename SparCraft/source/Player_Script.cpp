@@ -28,6 +28,7 @@ void Player_Script::getMove(const GameState & state, Move & move)
     
     _numTargeting.assign(state.getAllUnits().size(), 0);
     _damageAssigned.assign(state.getAllUnits().size(), 0);
+    _validTarget.assign(state.getAllUnits().size(), true);
 
     for (size_t u(0); u < state.numUnits(_playerID); ++u)
     {
@@ -39,7 +40,7 @@ void Player_Script::getMove(const GameState & state, Move & move)
             continue;
         }
 
-        getEnemyUnitsInAttackRange(unit, state, allEnemyUnits, _enemyUnitsInAttackRange);
+        getEnemyUnitsInAttackRange(unit, state, _enemyUnitsInAttackRange);
 
         Action unitAction;
 
@@ -107,6 +108,7 @@ void Player_Script::getMove(const GameState & state, Move & move)
             if (!_playerPolicy.getAllowOverkill() && allEnemyUnits.size() > 1 &&  (int)_damageAssigned[target.getID()] >= target.currentHP())
             {
                 allEnemyUnits.erase(std::remove(allEnemyUnits.begin(), allEnemyUnits.end(), target.getID()), allEnemyUnits.end());
+                _validTarget[target.getID()] = false;
             }
         }
 
@@ -281,20 +283,16 @@ const Position & Player_Script::getPlayerCenter(const GameState & state, const s
     return _playerCenters[playerID];
 }
 
-void Player_Script::getEnemyUnitsInAttackRange(const Unit & myUnit, const GameState & state, const std::vector<size_t> & enemyUnits, std::vector<size_t> & unitIDs)
+// enemy units this unit can attack right now, taken from the state's spatial index instead of testing
+// every enemy unit, targets dropped from consideration this move to prevent overkill are skipped
+void Player_Script::getEnemyUnitsInAttackRange(const Unit & myUnit, const GameState & state, std::vector<size_t> & unitIDs)
 {
-    const size_t enemy = state.getEnemy(_playerID);
-    unitIDs.clear();
-    
-    for (const size_t & enemyUnitID : enemyUnits)
-    {
-        const Unit & enemyUnit = state.getUnitByID(enemyUnitID);
-        
-        if (myUnit.canAttackTarget(enemyUnit, state.getTime()))
-        {
-            unitIDs.push_back(enemyUnitID);
-        }
-    }
+    state.getUnitIDsInRange(_enemyID, myUnit.currentPosition(state.getTime()), myUnit.range(), unitIDs);
+
+    unitIDs.erase(std::remove_if(unitIDs.begin(), unitIDs.end(), [&](const size_t & enemyUnitID) 
+    { 
+        return !_validTarget[enemyUnitID] || !myUnit.canTarget(state.getUnitByID(enemyUnitID)); 
+    }), unitIDs.end());
 }
 
 PlayerPtr Player_Script::clone()
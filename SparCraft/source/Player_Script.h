@@ -16,14 +16,13 @@ class Player_Script : public Player
     std::vector<size_t> _numTargeting;
     std::vector<size_t> _damageAssigned;
     std::vector<size_t> _enemyUnitsInAttackRange;
+    std::vector<bool>   _validTarget;
 
     std::vector<double> _val;
     std::vector<double> _bestVals;
 
-    std::vector< std::vector<double> > _distSq;
-
     const Position &    getPlayerCenter(const GameState & state, const size_t & playerID);
-    void                getEnemyUnitsInAttackRange(const Unit & myUnit, const GameState & state, const std::vector<size_t> & enemyUnits, std::vector<size_t> & unitIDs);
+    void                getEnemyUnitsInAttackRange(const Unit & myUnit, const GameState & state, std::vector<size_t> & unitIDs);
     Action              getPolicyAction        (const GameState & state, const Unit & myUnit, const ScriptPolicy & policy, const std::vector<size_t> & validUnitTargets);
     Position            getPolicyTargetPosition(const GameState & state, const Unit & myUnit, const ScriptPolicy & policy, const std::vector<size_t> & validUnitTargets);
     size_t              getPolicyTargetUnitID  (const GameState & state, const Unit & myUnit, const ScriptPolicy & policy, const std::vector<size_t> & validUnitTargets);
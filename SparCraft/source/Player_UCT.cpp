@@ -6,6 +6,12 @@ Player_UCT::Player_UCT (const size_t & playerID, const UCTSearchParameters & par
 {
 	_playerID = playerID;
     _params = params;
+    _memoryPool = std::make_shared<UCTMemoryPool>();
+
+    if (_params.transpositionTableSize() > 0)
+    {
+        _transpositionTable = std::make_shared<UCTTranspositionTable>(_params.transpositionTableSize());
+    }
 }
 
 void Player_UCT::getMove(const GameState & state, Move & move)
@@ -13,6 +19,8 @@ void Player_UCT::getMove(const GameState & state, Move & move)
     move.clear();
     
     UCTSearch uct(_params);
+    uct.setMemoryPool(_memoryPool.get());
+    uct.setTranspositionTable(_transpositionTable.get());
 
     uct.doSearch(state, move);
     _prevResults = uct.getResults();
@@ -30,5 +38,14 @@ UCTSearchResults & Player_UCT::getResults()
 
 PlayerPtr Player_UCT::clone()
 {
-    return PlayerPtr(new Player_UCT(*this));
+    // clones may search concurrently, so they can't share a memory pool
+    Player_UCT * player = new Player_UCT(*this);
+    player->_memoryPool = std::make_shared<UCTMemoryPool>();
+
+    if (_params.transpositionTableSize() > 0)
+    {
+        player->_transpositionTable = std::make_shared<UCTTranspositionTable>(_params.transpositionTableSize());
+    }
+
+    return PlayerPtr(player);
 }
\ No newline at end of file
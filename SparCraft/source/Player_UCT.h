@@ -12,6 +12,8 @@ class Player_UCT : public Player
 {
     UCTSearchParameters     _params;
     UCTSearchResults        _prevResults;
+    std::shared_ptr<UCTMemoryPool> _memoryPool;     // tree nodes are recycled from one move to the next
+    std::shared_ptr<UCTTranspositionTable> _transpositionTable; // allocated once, cleared by every search
 public:
     Player_UCT (const size_t & playerID, const UCTSearchParameters & params);
 	void getMove(const GameState & state, Move & move);
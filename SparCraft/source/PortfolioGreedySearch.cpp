@@ -5,6 +5,7 @@ using namespace SparCraft;
 
 PortfolioGreedySearch::PortfolioGreedySearch(const PGSParameters & params)
 	: _params(params)
+    , _playouts(0)
 {
 	
 }
@@ -35,9 +36,35 @@ void PortfolioGreedySearch::calculatePortfolioScriptMoves(const GameState & stat
 Move PortfolioGreedySearch::search(const GameState & state, const size_t & playerID)
 {
     _searchTimer.start();
+    _playouts = 0;
 
     const size_t enemyID = state.getEnemy(playerID);
 
+    _playoutState = state;
+    _playoutState.setUndoEnabled(true);
+
+    // a unit's scripts are evaluated as one batch, so more threads than scripts would never have work
+    const size_t numThreads = std::min(getNumThreads(), std::max(_params.getPortfolio(playerID).size(), _params.getPortfolio(enemyID).size()));
+    if (numThreads <= 1)
+    {
+        _threadPool.reset();
+    }
+    else
+    {
+        if (!_threadPool || _threadPool->numThreads() != numThreads)
+        {
+            _threadPool = std::make_shared<ThreadPool>(numThreads);
+        }
+
+        _threadPlayoutStates.assign(numThreads, state);
+        _threadScriptAssignments.resize(numThreads);
+
+        for (size_t t(0); t < numThreads; ++t)
+        {
+            _threadPlayoutStates[t].setUndoEnabled(true);
+        }
+    }
+
     // pre-compute the actions done for each unit that can move for each Player in the portfolio
     calculatePortfolioScriptMoves(state);
 
@@ -106,23 +133,21 @@ void PortfolioGreedySearch::doPortfolioSearch(const GameState & state, const siz
             }
 
             const Unit & unit = state.getUnitByID(_activeUnitIDs[playerID][unitIndex]);
+
+            // evaluate the current state given a playout for each script this unit can execute
+            evalScripts(unit.getID(), playerID);
+
             size_t bestScriptIndex = 0;
             StateEvalScore bestScriptScore;
 
-            // iterate over each script move that it can execute
-            for (size_t sIndex(0); sIndex < _params.getPortfolio(playerID).size(); ++sIndex)
+            // scores are compared in script order, so the choice doesn't depend on the number of threads
+            for (size_t sIndex(0); sIndex < _scriptScores.size(); ++sIndex)
             {
-                // set the current script for this unit
-                _currentScriptAssignment[unit.getID()] = sIndex;
-
-                // evaluate the current state given a playout with these unit scripts
-                StateEvalScore score = eval(state, playerID);
-
                 // if we have a better score, set it
-                if (sIndex == 0 || score > bestScriptScore)
+                if (sIndex == 0 || _scriptScores[sIndex] > bestScriptScore)
                 {
                     bestScriptIndex = sIndex;
-                    bestScriptScore = score;
+                    bestScriptScore = _scriptScores[sIndex];
                 }
             }
 
@@ -132,10 +157,65 @@ void PortfolioGreedySearch::doPortfolioSearch(const GameState & state, const siz
     }
 }
 
-StateEvalScore PortfolioGreedySearch::eval(const GameState & state, const size_t & playerID)
+// fills _scriptScores with the playout score of giving the unit each script of the portfolio
+// while every other unit keeps its current script
+void PortfolioGreedySearch::evalScripts(const size_t & unitID, const size_t & playerID)
+{
+    const size_t numScripts = _params.getPortfolio(playerID).size();
+    _scriptScores.resize(numScripts);
+    _playouts += numScripts;
+
+    if (!_threadPool)
+    {
+        for (size_t sIndex(0); sIndex < numScripts; ++sIndex)
+        {
+            _currentScriptAssignment[unitID] = sIndex;
+            _scriptScores[sIndex] = eval(_playoutState, playerID, _currentScriptAssignment);
+        }
+
+        return;
+    }
+
+    _threadPool->run(numScripts, [this, &unitID, &playerID](const size_t & sIndex, const size_t & thread)
+    {
+        std::unordered_map<size_t, size_t> & scriptAssignment = _threadScriptAssignments[thread];
+        scriptAssignment = _currentScriptAssignment;
+        scriptAssignment[unitID] = sIndex;
+
+        _scriptScores[sIndex] = eval(_threadPlayoutStates[thread], playerID, scriptAssignment);
+    });
+}
+
+const size_t & PortfolioGreedySearch::getNumPlayouts() const
+{
+    return _playouts;
+}
+
+void PortfolioGreedySearch::setThreadPool(const std::shared_ptr<ThreadPool> & threadPool)
+{
+    _threadPool = threadPool;
+}
+
+const std::shared_ptr<ThreadPool> & PortfolioGreedySearch::getThreadPool() const
+{
+    return _threadPool;
+}
+
+const size_t PortfolioGreedySearch::getNumThreads() const
+{
+    if (_params.getThreads() == 0)
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    return _params.getThreads();
+}
+
+StateEvalScore PortfolioGreedySearch::eval(GameState & currentState, const size_t & playerID, std::unordered_map<size_t, size_t> & scriptAssignment)
 {
     // Do a playout of the current state using the current script assignments
-    GameState currentState(state);
+    // the state is modified in place and rolled back to this mark afterwards
+    const size_t undoMark = currentState.getUndoMark();
     const size_t maxTurns = _params.getMaxPlayoutTurns();
 
     for (size_t turns(0); (!maxTurns || turns < maxTurns) && !currentState.gameOver(); ++turns)
@@ -162,14 +242,17 @@ StateEvalScore PortfolioGreedySearch::eval(const GameState & state, const size_t
             for (size_t a(0); a < portfolioMoves[p].back().size(); ++a)
             {
                 const size_t unitID = portfolioMoves[p].back()[a].getID();
-                turnMove[p].addAction(portfolioMoves[p][_currentScriptAssignment[unitID]][a]);
+                turnMove[p].addAction(portfolioMoves[p][scriptAssignment[unitID]][a]);
             }
         }
 
         currentState.doMove(turnMove[0], turnMove[1]);
     }
 
-    return Eval::Eval(currentState, playerID, EvaluationMethods::LTD);
+    StateEvalScore score = Eval::Eval(currentState, playerID, EvaluationMethods::LTD);
+    currentState.undo(undoMark);
+
+    return score;
 }
 
 size_t PortfolioGreedySearch::calculateInitialSeed(const GameState & state, const size_t & playerID, const PlayerPtr & enemyPlayer)
@@ -179,7 +262,7 @@ size_t PortfolioGreedySearch::calculateInitialSeed(const GameState & state, cons
     const size_t enemyPlayerID = state.getEnemy(playerID);
     
     PlayerPtr players[2];
-    players[enemyPlayerID] = enemyPlayer;
+    players[enemyPlayerID] = enemyPlayer->clone();
 
     // evaluate every Player in this player's portfolio against the chosen enemy Player
     for (size_t s(0); s < _params.getPortfolio(playerID).size(); ++s)
@@ -188,6 +271,7 @@ size_t PortfolioGreedySearch::calculateInitialSeed(const GameState & state, cons
         players[playerID] = selfPlayer;
 
         StateEvalScore score = Eval::Eval(state, playerID, EvaluationMethods::Playout, players[0], players[1]);
+        _playouts++;
 
         if (s == 0 || score > bestScriptScore)
         {
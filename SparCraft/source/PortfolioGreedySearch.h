@@ -7,6 +7,7 @@
 #include "Action.h"
 #include "PGSParameters.h"
 #include "Eval.h"
+#include "ThreadPool.hpp"
 #include <memory>
 
 namespace SparCraft
@@ -19,20 +20,37 @@ class PortfolioGreedySearch
     size_t                      _seedScriptIndex[2];
     std::vector<size_t>         _activeUnitIDs[2];
     Timer                       _searchTimer;
+    GameState                   _playoutState;      // working copy of the searched state, playouts are rolled back with its undo log
+    size_t                      _playouts;          // playouts evaluated by the last search
 
     std::vector<Move>           _portfolioScriptMoves[2];
     std::unordered_map<size_t, size_t> _currentScriptAssignment;
+
+    // batch evaluation of a unit's scripts, every pool thread plays out on its own state and assignment
+    // the pool can be handed in and taken back out so a player keeps its threads from one search to the next
+    std::shared_ptr<ThreadPool> _threadPool;
+    std::vector<GameState>      _threadPlayoutStates;
+    std::vector< std::unordered_map<size_t, size_t> > _threadScriptAssignments;
+    std::vector<StateEvalScore> _scriptScores;
     
     void                        doPortfolioSearch(const GameState & state, const size_t & playerID);
+    void                        evalScripts(const size_t & unitID, const size_t & playerID);
     void                        calculatePortfolioScriptMoves(const GameState & state);
     size_t                      calculateInitialSeed(const GameState & state, const size_t & playerID, const PlayerPtr & enemyPlayer);
-    StateEvalScore              eval(const GameState & state, const size_t & playerID);
+    StateEvalScore              eval(GameState & state, const size_t & playerID, std::unordered_map<size_t, size_t> & scriptAssignment);
+    const size_t                getNumThreads() const;
 
 public:
 
     PortfolioGreedySearch(const PGSParameters & params);
 
     Move search(const GameState & state, const size_t & player);
+
+    const size_t & getNumPlayouts() const;
+
+    // the pool is only replaced by a search that needs a different number of threads
+    void setThreadPool(const std::shared_ptr<ThreadPool> & threadPool);
+    const std::shared_ptr<ThreadPool> & getThreadPool() const;
 };
 
 }
\ No newline at end of file
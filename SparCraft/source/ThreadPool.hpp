@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Common.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+namespace SparCraft
+{
+
+// fixed size pool of worker threads that runs batches of independent tasks
+// run() blocks until every task of the batch is done and the calling thread works on the batch
+// as thread 0, so a pool of n threads starts n-1 workers. tasks write their results to slots
+// indexed by task number, which keeps the results independent of the order the tasks finish in
+class ThreadPool
+{
+    typedef std::function<void(const size_t & task, const size_t & thread)> Task;
+
+    std::vector<std::thread>            _workers;
+    std::mutex                          _mutex;
+    std::condition_variable             _workReady;
+    std::condition_variable             _workDone;
+
+    Task                                _task;
+    size_t                              _numTasks;
+    size_t                              _nextTask;
+    size_t                              _tasksDone;
+    bool                                _stop;
+    std::vector<std::exception_ptr>     _exceptions;        // exception thrown by each task of the batch
+
+    // run tasks of the current batch until none are left to start
+    void work(std::unique_lock<std::mutex> & lock, const size_t & thread)
+    {
+        while (_nextTask < _numTasks)
+        {
+            const size_t task = _nextTask++;
+            lock.unlock();
+
+            try
+            {
+                _task(task, thread);
+            }
+            catch (...)
+            {
+                _exceptions[task] = std::current_exception();
+            }
+
+            lock.lock();
+
+            if (++_tasksDone == _numTasks)
+            {
+                _workDone.notify_all();
+            }
+        }
+    }
+
+    void workerLoop(const size_t thread)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true)
+        {
+            _workReady.wait(lock, [this]() { return _stop || _nextTask < _numTasks; });
+
+            if (_stop)
+            {
+                return;
+            }
+
+            work(lock, thread);
+        }
+    }
+
+public:
+
+    ThreadPool(const size_t & numThreads)
+        : _numTasks     (0)
+        , _nextTask     (0)
+        , _tasksDone    (0)
+        , _stop         (false)
+    {
+        for (size_t t(1); t < numThreads; ++t)
+        {
+            _workers.push_back(std::thread(&ThreadPool::workerLoop, this, t));
+        }
+    }
+
+    ThreadPool(const ThreadPool & pool) = delete;
+    ThreadPool & operator = (const ThreadPool & pool) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+
+        _workReady.notify_all();
+
+        for (size_t t(0); t < _workers.size(); ++t)
+        {
+            _workers[t].join();
+        }
+    }
+
+    const size_t numThreads() const
+    {
+        return _workers.size() + 1;
+    }
+
+    // runs task(i, thread) for every i in [0, numTasks), the exception of the lowest failed task is rethrown
+    void run(const size_t & numTasks, const Task & task)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        _task = task;
+        _exceptions.assign(numTasks, std::exception_ptr());
+        _tasksDone = 0;
+        _nextTask = 0;
+        _numTasks = numTasks;
+
+        _workReady.notify_all();
+
+        work(lock, 0);
+
+        _workDone.wait(lock, [this]() { return _tasksDone == _numTasks; });
+
+        for (size_t t(0); t < numTasks; ++t)
+        {
+            if (_exceptions[t])
+            {
+                std::rethrow_exception(_exceptions[t]);
+            }
+        }
+    }
+};
+
+}
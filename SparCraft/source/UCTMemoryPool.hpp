@@ -2,54 +2,92 @@
 
 #include "Common.h"
 #include "UCTNode.h"
+#include <memory>
 
 namespace SparCraft
 {
     class UCTMemoryPool;
 }
 
+// bump allocator for UCT search trees
+// nodes are handed out as contiguous child blocks from fixed size arena blocks which are never
+// resized, so node addresses stay valid while the arena grows. clearPool() rewinds the arena in O(1)
+// and recycled nodes are re-initialized by UCTNode::reset, so a search that fits in the memory used
+// by previous searches does no heap allocation for its tree
 class SparCraft::UCTMemoryPool
-{	
-    std::vector< std::vector<UCTNode> > _pool;
+{
+    std::vector< std::vector<UCTNode> >             _blocks;
+    std::vector< std::shared_ptr<UCTMemoryPool> >   _threadPools;   // private arenas for root parallel search threads
+
+    const size_t    _blockSize;
 
-    const size_t    _poolSize;
-    const size_t    _maxChildren;
-    
-    size_t    _currentIndex;
+    size_t          _currentBlock;
+    size_t          _currentIndex;
+    size_t          _nodesAllocated;
 
 public:
 
-	UCTMemoryPool(const size_t & poolSize, const size_t & maxChildren)
-        : _pool             (poolSize, std::vector<UCTNode>())
-        , _poolSize         (poolSize)
-        , _maxChildren      (maxChildren)
+	UCTMemoryPool(const size_t & blockSize = 16384)
+        : _blockSize        (blockSize)
+        , _currentBlock     (0)
         , _currentIndex     (0)
+        , _nodesAllocated   (0)
+    {
+    }
+
+    // returns the first node of numNodes contiguous nodes
+    UCTNode * alloc(const size_t & numNodes)
     {
-        for (size_t s(0); s<poolSize; ++s)
+        SPARCRAFT_ASSERT(numNodes <= _blockSize, "UCTMemoryPool block size too small: requested=%d, block size=%d", numNodes, _blockSize);
+
+        // move on to the next block if the request doesn't fit into the current one
+        if (_currentBlock < _blocks.size() && _currentIndex + numNodes > _blockSize)
         {
-            _pool[s].reserve(maxChildren);
+            _currentBlock++;
+            _currentIndex = 0;
         }
+
+        if (_currentBlock == _blocks.size())
+        {
+            _blocks.push_back(std::vector<UCTNode>(_blockSize));
+        }
+
+        UCTNode * nodes = &_blocks[_currentBlock][_currentIndex];
+        _currentIndex += numNodes;
+        _nodesAllocated += numNodes;
+
+        return nodes;
     }
 
-    std::vector<UCTNode> * alloc()
+    UCTMemoryPool & getThreadPool(const size_t & thread)
     {
-        std::vector<UCTNode> & ret(_pool[_currentIndex]);
-        if (ret.size() > 0)
+        while (_threadPools.size() <= thread)
         {
-            ret.clear();
+            _threadPools.push_back(std::make_shared<UCTMemoryPool>(_blockSize));
         }
 
-        _currentIndex = (_currentIndex + 1) % _poolSize;
-        return &ret;
+        return *_threadPools[thread];
+    }
+
+    const size_t & nodesAllocated() const
+    {
+        return _nodesAllocated;
+    }
+
+    const size_t capacity() const
+    {
+        return _blocks.size() * _blockSize;
     }
 
     void clearPool()
     {
-        for (size_t i(0); i<_poolSize; ++i)
+        _currentBlock = 0;
+        _currentIndex = 0;
+        _nodesAllocated = 0;
+
+        for (size_t t(0); t < _threadPools.size(); ++t)
         {
-            _pool[i].clear();
+            _threadPools[t]->clearPool();
         }
-
-        _currentIndex = 0;
     }
 };
@@ -2,6 +2,7 @@
 
 #include "Common.h"
 #include "Action.h"
+#include "UCTTranspositionTable.hpp"
 
 namespace SparCraft
 {
@@ -13,17 +14,24 @@ class UCTNode
     size_t                      _numVisits;         // total visits to this node
     double                      _numWins;           // wins from this node
     double                      _uctVal;            // previous computed UCT value
+    size_t                      _virtualLoss;       // virtual loss currently added by tree parallel threads below this node
             
     // game specific variables
     size_t                      _player;            // the player who made a move to generate this node
     size_t                      _nodeType;
     Move     _move;              // the ove that generated this node
 
-    // holds children
-    std::vector<UCTNode>        _children;
+    // children live in a contiguous block handed out by a UCTMemoryPool, the node does not own them
+    UCTNode *                   _children;          // first node of the child block
+    size_t                      _numChildren;       // children used in the block
+    size_t                      _maxChildren;       // capacity of the block
 
     // nodes for traversing the tree
     UCTNode *                   _parent;
+
+    // transposition links, set when the node is first visited
+    UCTTranspositionEntry *     _entry;             // statistics shared with nodes leading to the same position
+    UCTNode *                   _transposition;     // node whose children this node shares, if another node got there first
     
 public:
 
@@ -31,42 +39,118 @@ public:
         : _numVisits            (0)
         , _numWins              (0)
         , _uctVal               (0)
+        , _virtualLoss          (0)
         , _player               (Players::Player_None)
         , _nodeType             (SearchNodeType::Default)
+        , _children             (NULL)
+        , _numChildren          (0)
+        , _maxChildren          (0)
         , _parent               (NULL)
+        , _entry                (NULL)
+        , _transposition        (NULL)
     {
 
     }
 
-    UCTNode (UCTNode * parent, const size_t player, const size_t nodeType, const Move & move, const size_t & maxChildren, std::vector<UCTNode> * fromPool = NULL)
+    UCTNode (UCTNode * parent, const size_t player, const size_t nodeType, const Move & move)
         : _numVisits            (0)
         , _numWins              (0)
         , _uctVal               (0)
+        , _virtualLoss          (0)
         , _player               (player)
         , _nodeType             (nodeType)
         , _move                 (move)
+        , _children             (NULL)
+        , _numChildren          (0)
+        , _maxChildren          (0)
         , _parent               (parent)
+        , _entry                (NULL)
+        , _transposition        (NULL)
+    {
+    }
+
+    // re-initialize a node in place, a recycled pool node keeps the capacity of its move vector
+    void reset(UCTNode * parent, const size_t player, const size_t nodeType, const Move & move)
     {
-        _children.reserve(maxChildren);
+        _numVisits      = 0;
+        _numWins        = 0;
+        _uctVal         = 0;
+        _virtualLoss    = 0;
+        _player         = player;
+        _nodeType       = nodeType;
+        _move           = move;
+        _children       = NULL;
+        _numChildren    = 0;
+        _maxChildren    = 0;
+        _parent         = parent;
+        _entry          = NULL;
+        _transposition  = NULL;
     }
 
     const size_t    numVisits()                 const           { return _numVisits; }
     const double    numWins()                   const           { return _numWins; }
-    const size_t    numChildren()               const           { return _children.size(); }
+    const size_t    numChildren()               const           { return _numChildren; }
     const double    getUCTVal()                 const           { return _uctVal; }
     const bool      hasChildren()               const           { return numChildren() > 0; }
     const size_t    getNodeType()               const           { return _nodeType; }
     const size_t    getPlayer()                 const           { return _player; }
 
     UCTNode *       getParent()                 const           { return _parent; }
+    UCTTranspositionEntry * getTranspositionEntry() const       { return _entry; }
     const UCTNode & getChild(const size_t & c)  const           { return _children[c]; }
     UCTNode &       getChild(const size_t & c)                  { return _children[c]; }
 
     void            setUCTVal(double val)                       { _uctVal = val; }
     void            incVisits()                                 { _numVisits++; }
+    void            addVisits(const size_t & visits)            { _numVisits += visits; }
     void            addWins(double val)                         { _numWins += val; }
+    void            setTranspositionEntry(UCTTranspositionEntry * entry) { _entry = entry; }
+    void            setTransposition(UCTNode * node)            { _transposition = node; }
 
-    std::vector<UCTNode> & getChildren()                        { return _children; }
+    // the node whose children are expanded and selected from when traversing through this node
+    UCTNode &       expansionNode()                             { return _transposition ? *_transposition : *this; }
+
+    // win rate of the position this node leads to, shared between transpositions when possible
+    // the shared statistics don't see virtual loss, so the node's own are used while a thread is below it
+    const double winRate() const
+    {
+        if (_entry && _virtualLoss == 0 && _entry->visits.load(std::memory_order_relaxed) > 0)
+        {
+            return _entry->winRate();
+        }
+
+        return _numWins / (double)_numVisits;
+    }
+
+    // visits of the position this node leads to, counting visits through its transpositions
+    const size_t positionVisits() const
+    {
+        return (_entry && _virtualLoss == 0) ? std::max(_numVisits, _entry->visits.load(std::memory_order_relaxed)) : _numVisits;
+    }
+
+    // virtual loss makes this node look like it lost 'loss' extra playouts for the player choosing it,
+    // so other tree parallel threads select its siblings until the real playout result is backed up
+    void addVirtualLoss(const size_t & loss, const bool maxPlayer)
+    {
+        _virtualLoss += loss;
+        _numVisits += loss;
+
+        if (!maxPlayer)
+        {
+            _numWins += loss;
+        }
+    }
+
+    void removeVirtualLoss(const size_t & loss, const bool maxPlayer)
+    {
+        _virtualLoss -= loss;
+        _numVisits -= loss;
+
+        if (!maxPlayer)
+        {
+            _numWins -= loss;
+        }
+    }
 
     const Move & getMove() const
     {
@@ -78,9 +162,18 @@ public:
         _move = move;
     }
 
-    void addChild(UCTNode * parent, const size_t player, const size_t nodeType, const Move & move, const size_t & maxChildren, std::vector<UCTNode> * fromPool = NULL)
+    void setChildBlock(UCTNode * block, const size_t & maxChildren)
     {
-        _children.push_back(UCTNode(parent, player, nodeType, move, maxChildren));
+        _children       = block;
+        _numChildren    = 0;
+        _maxChildren    = maxChildren;
+    }
+
+    void addChild(UCTNode * parent, const size_t player, const size_t nodeType, const Move & move)
+    {
+        SPARCRAFT_ASSERT(_numChildren < _maxChildren, "UCTNode child block is full: capacity=%d", _maxChildren);
+
+        _children[_numChildren++].reset(parent, player, nodeType, move);
     }
 
     UCTNode & mostVisitedChild() 
@@ -112,7 +205,7 @@ public:
         {
             UCTNode & child = getChild(c);
        
-            double winRate      = (double)child.numWins() / (double)child.numVisits();
+            double winRate      = child.winRate();
             double uctVal       = params.cValue() * sqrt( log( (double)numVisits() ) / ( child.numVisits() ) );
 			double currentVal   = maxPlayer ? (winRate + uctVal) : (winRate - uctVal);
 
@@ -1,11 +1,15 @@
 #include "UCTSearch.h"
 #include "SparCraftAssert.h"
+#include "Hash.h"
+#include <thread>
+#include <exception>
 
 using namespace SparCraft;
 
 UCTSearch::UCTSearch(const UCTSearchParameters & params) 
 	: _params(params)
     , _memoryPool(NULL)
+    , _transpositionTable(NULL)
 {
     for (size_t p(0); p<Players::Num_Players; ++p)
     {
@@ -28,31 +32,69 @@ void UCTSearch::setMemoryPool(UCTMemoryPool * pool)
     _memoryPool = pool;
 }
 
+UCTMemoryPool & UCTSearch::getMemoryPool()
+{
+    if (!_memoryPool)
+    {
+        _ownedMemoryPool = std::make_shared<UCTMemoryPool>();
+        _memoryPool = _ownedMemoryPool.get();
+    }
+
+    return *_memoryPool;
+}
+
+void UCTSearch::setTranspositionTable(UCTTranspositionTable * table)
+{
+    _transpositionTable = table;
+}
+
+// returns nullptr if transpositions are disabled
+UCTTranspositionTable * UCTSearch::getTranspositionTable()
+{
+    if (_params.transpositionTableSize() == 0)
+    {
+        return nullptr;
+    }
+
+    if (!_transpositionTable)
+    {
+        _ownedTranspositionTable = std::make_shared<UCTTranspositionTable>(_params.transpositionTableSize());
+        _transpositionTable = _ownedTranspositionTable.get();
+    }
+
+    return _transpositionTable;
+}
+
 void UCTSearch::doSearch(const GameState & initialState, Move & move)
 {
     Timer t;
     t.start();
 
-    _rootNode = UCTNode(NULL, Players::Player_None, SearchNodeType::RootNode, _actionVec, _params.maxChildren(), _memoryPool ? _memoryPool->alloc() : NULL);
+    // nodes from the previous search are recycled
+    getMemoryPool().clearPool();
 
-    // do the required number of traversals
-    for (size_t traversals(0); traversals < _params.maxTraversals(); ++traversals)
+    // transposition statistics only hold for the positions of this search
+    if (getTranspositionTable())
     {
-        GameState state(initialState);
-        traverse(_rootNode, state);
+        getTranspositionTable()->clear();
+    }
 
-        if (traversals && (traversals % 5 == 0))
-        {
-            if (_params.timeLimit() && (t.getElapsedTimeInMilliSec() >= _params.timeLimit()))
-            {
-                break;
-            }
-        }
+    _rootNode = UCTNode(NULL, Players::Player_None, SearchNodeType::RootNode, _actionVec);
 
-        _results.traversals++;
+    const size_t numThreads = getNumThreads();
 
-        //printSubTree(_rootNode, initialState, "__uct.txt");
-        //system("\"C:\\Program Files (x86)\\Graphviz2.30\\bin\\dot.exe\" < __uct.txt -Tpng > uct.png");
+    if (numThreads <= 1)
+    {
+        runTraversals(initialState, _params.maxTraversals());
+        _results.threadTraversals.push_back(_results.traversals);
+    }
+    else if (_params.parallelMethod() == UCTParallelMethod::TreeParallel)
+    {
+        doTreeParallelSearch(initialState, numThreads);
+    }
+    else
+    {
+        doRootParallelSearch(initialState, numThreads);
     }
 
     // choose the move to return
@@ -77,6 +119,325 @@ void UCTSearch::doSearch(const GameState & initialState, Move & move)
     //printf("Hello\n");
 }
 
+void UCTSearch::runTraversals(const GameState & initialState, const size_t & maxTraversals)
+{
+    Timer t;
+    t.start();
+
+    // with the undo log every traversal works on this one copy and rolls it back afterwards
+    GameState state(initialState);
+    state.setUndoEnabled(_params.useUndoLog());
+    const size_t undoMark = state.getUndoMark();
+
+    // do the required number of traversals
+    for (size_t traversals(0); traversals < maxTraversals; ++traversals)
+    {
+        if (_params.useUndoLog())
+        {
+            traverse(_rootNode, state);
+            state.undo(undoMark);
+        }
+        else
+        {
+            GameState traversalState(initialState);
+            traverse(_rootNode, traversalState);
+        }
+
+        if (traversals && (traversals % 5 == 0))
+        {
+            if (_params.timeLimit() && (t.getElapsedTimeInMilliSec() >= _params.timeLimit()))
+            {
+                break;
+            }
+        }
+
+        _results.traversals++;
+
+        //printSubTree(_rootNode, initialState, "__uct.txt");
+        //system("\"C:\\Program Files (x86)\\Graphviz2.30\\bin\\dot.exe\" < __uct.txt -Tpng > uct.png");
+    }
+}
+
+const size_t UCTSearch::getNumThreads() const
+{
+    if (_params.numThreads() == 0)
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    return _params.numThreads();
+}
+
+// root parallelization: every thread searches its own private tree from the initial state,
+// and the statistics of the root children are summed into our root at the end
+void UCTSearch::doRootParallelSearch(const GameState & initialState, const size_t & numThreads)
+{
+    UCTSearchParameters threadParams(_params);
+    threadParams.setNumThreads(1);
+
+    std::vector<UCTSearch> threadSearches(numThreads, UCTSearch(threadParams));
+    std::vector<std::exception_ptr> threadExceptions(numThreads);
+    std::vector<std::thread> threads;
+
+    // each private tree is allocated from its own arena
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threadSearches[t].setMemoryPool(&getMemoryPool().getThreadPool(t));
+        threadSearches[t].setTranspositionTable(getTranspositionTable());
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        // split the traversal budget evenly, the first threads take the remainder
+        const size_t threadTraversals = _params.maxTraversals() / numThreads + (t < _params.maxTraversals() % numThreads ? 1 : 0);
+
+        threads.push_back(std::thread([&initialState, &threadSearches, &threadExceptions, t, threadTraversals]()
+        {
+            try
+            {
+                UCTSearch & search = threadSearches[t];
+                search._rootNode = UCTNode(NULL, Players::Player_None, SearchNodeType::RootNode, search._actionVec);
+                search.runTraversals(initialState, threadTraversals);
+            }
+            catch (...)
+            {
+                threadExceptions[t] = std::current_exception();
+            }
+        }));
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads[t].join();
+    }
+
+    // the merged root gets a child block large enough for every distinct child the threads generated
+    size_t totalChildren = 0;
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        totalChildren += threadSearches[t]._rootNode.numChildren();
+    }
+
+    _rootNode.setChildBlock(getMemoryPool().alloc(totalChildren), totalChildren);
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        if (threadExceptions[t])
+        {
+            std::rethrow_exception(threadExceptions[t]);
+        }
+
+        mergeRootChildren(threadSearches[t]._rootNode);
+        addThreadResults(threadSearches[t].getResults());
+    }
+}
+
+// tree parallelization: every thread traverses our shared tree, which is protected by a single mutex
+// only playouts run unlocked, and virtual loss spreads concurrent traversals over different children
+void UCTSearch::doTreeParallelSearch(const GameState & initialState, const size_t & numThreads)
+{
+    UCTSearchParameters threadParams(_params);
+    threadParams.setNumThreads(1);
+
+    std::mutex treeMutex;
+    std::atomic<size_t> traversalsLeft(_params.maxTraversals());
+
+    std::vector<UCTSearch> threadSearches(numThreads, UCTSearch(threadParams));
+    std::vector<std::exception_ptr> threadExceptions(numThreads);
+    std::vector<std::thread> threads;
+
+    // children are only generated while holding the tree lock, so all threads can share our arena
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threadSearches[t].setMemoryPool(&getMemoryPool());
+        threadSearches[t].setTranspositionTable(getTranspositionTable());
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads.push_back(std::thread([this, &initialState, &threadSearches, &threadExceptions, &treeMutex, &traversalsLeft, t]()
+        {
+            try
+            {
+                threadSearches[t].runSharedTraversals(initialState, _rootNode, treeMutex, traversalsLeft);
+            }
+            catch (...)
+            {
+                threadExceptions[t] = std::current_exception();
+            }
+        }));
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads[t].join();
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        if (threadExceptions[t])
+        {
+            std::rethrow_exception(threadExceptions[t]);
+        }
+
+        addThreadResults(threadSearches[t].getResults());
+    }
+}
+
+void UCTSearch::runSharedTraversals(const GameState & initialState, UCTNode & root, std::mutex & treeMutex, std::atomic<size_t> & traversalsLeft)
+{
+    Timer t;
+    t.start();
+
+    GameState state(initialState);
+    state.setUndoEnabled(_params.useUndoLog());
+    const size_t undoMark = state.getUndoMark();
+
+    for (size_t traversals(0); ; ++traversals)
+    {
+        // claim one traversal from the shared budget
+        size_t left = traversalsLeft.load();
+        do
+        {
+            if (left == 0)
+            {
+                return;
+            }
+        }
+        while (!traversalsLeft.compare_exchange_weak(left, left - 1));
+
+        if (_params.useUndoLog())
+        {
+            traverseShared(root, state, treeMutex);
+            state.undo(undoMark);
+        }
+        else
+        {
+            GameState traversalState(initialState);
+            traverseShared(root, traversalState, treeMutex);
+        }
+
+        if (traversals && (traversals % 5 == 0))
+        {
+            if (_params.timeLimit() && (t.getElapsedTimeInMilliSec() >= _params.timeLimit()))
+            {
+                break;
+            }
+        }
+
+        _results.traversals++;
+    }
+}
+
+// iterative version of traverse() for a tree shared between threads
+// selection and expansion happen while holding the tree lock, the playout does not
+StateEvalScore UCTSearch::traverseShared(UCTNode & root, GameState & currentState, std::mutex & treeMutex)
+{
+    StateEvalScore playoutVal;
+    bool doPlayout = false;
+
+    _traversalPath.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+
+        UCTNode * node = &root;
+        while (true)
+        {
+            _results.totalVisits++;
+            _traversalPath.push_back(node);
+
+            const bool firstVisit = node->numVisits() == 0;
+            node->addVirtualLoss(_params.virtualLoss(), node->getPlayer() == _params.maxPlayer());
+
+            // if we haven't visited this node yet, do a playout once the lock is released
+            if (firstVisit)
+            {
+                updateState(*node, currentState, true);
+                linkTransposition(*node, currentState);
+                doPlayout = true;
+
+                _results.nodesVisited++;
+                break;
+            }
+
+            // update the state for a non-leaf node
+            updateState(*node, currentState, false);
+
+            if (currentState.gameOver())
+            {
+                playoutVal = Eval::Eval(currentState, _params.maxPlayer(), EvaluationMethods::LTD2);
+                break;
+            }
+
+            // a transposed node expands and selects through the node that reached its position first
+            UCTNode & expansionNode = node->expansionNode();
+
+            // if the children haven't been generated yet
+            if (!expansionNode.hasChildren())
+            {
+                generateChildren(expansionNode, currentState);
+            }
+
+            node = &UCTNodeSelect(expansionNode);
+        }
+    }
+
+    if (doPlayout)
+    {
+        playoutVal = performPlayout(currentState);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+
+        for (UCTNode * node : _traversalPath)
+        {
+            node->removeVirtualLoss(_params.virtualLoss(), node->getPlayer() == _params.maxPlayer());
+            updateStats(*node, playoutVal);
+        }
+    }
+
+    return playoutVal;
+}
+
+// add the root children statistics of a thread's private tree into our root
+void UCTSearch::mergeRootChildren(const UCTNode & root)
+{
+    _rootNode.addVisits(root.numVisits());
+    _rootNode.addWins(root.numWins());
+
+    for (size_t c(0); c < root.numChildren(); ++c)
+    {
+        const UCTNode & threadChild = root.getChild(c);
+
+        size_t index = 0;
+        while (index < _rootNode.numChildren() && !(_rootNode.getChild(index).getMove() == threadChild.getMove()))
+        {
+            ++index;
+        }
+
+        if (index == _rootNode.numChildren())
+        {
+            _rootNode.addChild(&_rootNode, threadChild.getPlayer(), threadChild.getNodeType(), threadChild.getMove());
+        }
+
+        _rootNode.getChild(index).addVisits(threadChild.numVisits());
+        _rootNode.getChild(index).addWins(threadChild.numWins());
+    }
+}
+
+void UCTSearch::addThreadResults(const UCTSearchResults & threadResults)
+{
+    _results.traversals     += threadResults.traversals;
+    _results.nodesVisited   += threadResults.nodesVisited;
+    _results.totalVisits    += threadResults.totalVisits;
+    _results.nodesCreated   += threadResults.nodesCreated;
+    _results.transpositions += threadResults.transpositions;
+
+    _results.threadTraversals.push_back(threadResults.traversals);
+}
+
 const bool UCTSearch::searchTimeOut()
 {
 	return (_params.timeLimit() && (_searchTimer.getElapsedTimeInMilliSec() >= _params.timeLimit()));
@@ -253,8 +614,9 @@ UCTNode & UCTSearch::UCTNodeSelect(UCTNode & parent)
         // if we have visited this node already, get its UCT value
 		if (child.numVisits() > 0)
 		{
-			double winRate    = (double)child.numWins() / (double)child.numVisits();
-            double uctVal     = _params.cValue() * sqrt( log( (double)parent.numVisits() ) / ( child.numVisits() ) );
+            // the value is shared between transpositions, exploration counts visits along this edge
+			double winRate    = child.winRate();
+            double uctVal     = _params.cValue() * sqrt( log( (double)parent.positionVisits() ) / ( child.numVisits() ) );
 			currentVal        = maxPlayer ? (winRate + uctVal) : (winRate - uctVal);
             
             child.setUCTVal(currentVal);
@@ -313,6 +675,7 @@ StateEvalScore UCTSearch::traverse(UCTNode & node, GameState & currentState)
         // update the status of the current state with this node's moves
         //updateState(node, currentState, !node.hasChildren());
         updateState(node, currentState, true);
+        linkTransposition(node, currentState);
 
         // do the playout
         playoutVal = Eval::Eval(currentState, _params.maxPlayer(), _params.evalMethod(), _params.playoutPlayer(Players::Player_One), _params.playoutPlayer(Players::Player_Two));
@@ -331,17 +694,27 @@ StateEvalScore UCTSearch::traverse(UCTNode & node, GameState & currentState)
         }
         else
         {
+            // a transposed node expands and selects through the node that reached its position first
+            UCTNode & expansionNode = node.expansionNode();
+
             // if the children haven't been generated yet
-            if (!node.hasChildren())
+            if (!expansionNode.hasChildren())
             {
-                generateChildren(node, currentState);
+                generateChildren(expansionNode, currentState);
             }
 
-            UCTNode & next = UCTNodeSelect(node);
+            UCTNode & next = UCTNodeSelect(expansionNode);
             playoutVal = traverse(next, currentState);
         }
     }
 
+    updateStats(node, playoutVal);
+
+    return playoutVal;
+}
+
+void UCTSearch::updateStats(UCTNode & node, const StateEvalScore & playoutVal)
+{
     node.incVisits();
     
     if (playoutVal.val() > 0)
@@ -353,7 +726,51 @@ StateEvalScore UCTSearch::traverse(UCTNode & node, GameState & currentState)
         node.addWins(0.5);
     }
 
-    return playoutVal;
+    UCTTranspositionEntry * entry = node.getTranspositionEntry();
+    if (entry)
+    {
+        entry->visits.fetch_add(1, std::memory_order_relaxed);
+        entry->halfWins.fetch_add(playoutVal.val() > 0 ? 2 : (playoutVal.val() == 0 ? 1 : 0), std::memory_order_relaxed);
+    }
+}
+
+// called on a node's first visit with the state its moves lead to
+// the node shares the statistics of its position with every other node leading there, and if an earlier
+// node of the same tree got there first it shares that node's children too. positions are keyed by the
+// state hash together with the node type and player, since those decide how the children are generated
+// first sim nodes are skipped, their move isn't applied to the state until the second sim move is chosen
+void UCTSearch::linkTransposition(UCTNode & node, const GameState & state)
+{
+    UCTTranspositionTable * table = getTranspositionTable();
+
+    if (!table || isRoot(node) || node.getNodeType() == SearchNodeType::FirstSimNode)
+    {
+        return;
+    }
+
+    const HashType key = state.getHash() ^ Hash::Mix(node.getNodeType() * Players::Num_Players + node.getPlayer() + 1);
+    UCTTranspositionEntry * entry = table->find(key);
+
+    if (!entry)
+    {
+        return;
+    }
+
+    node.setTranspositionEntry(entry);
+
+    // root parallel threads share statistics, but each only expands nodes of its own tree
+    const void * owner = &getMemoryPool();
+    UCTNode * canonical = nullptr;
+
+    if (entry->node.compare_exchange_strong(canonical, &node, std::memory_order_acq_rel))
+    {
+        entry->owner.store(owner, std::memory_order_release);
+    }
+    else if (canonical != &node && entry->owner.load(std::memory_order_acquire) == owner)
+    {
+        node.setTransposition(canonical);
+        _results.transpositions++;
+    }
 }
 
 // generate the children of state 'node'
@@ -366,11 +783,13 @@ void UCTSearch::generateChildren(UCTNode & node, GameState & state)
     // generate the 'ordered moves' for move ordering
     generateOrderedMoves(state, playerToMove);
 
+    node.setChildBlock(getMemoryPool().alloc(_params.maxChildren()), _params.maxChildren());
+
     // for each child of this state, add a child to the current node
     for (size_t child(0); (child < _params.maxChildren()) && getNextMove(playerToMove, _moveArray, child, _actionVec); ++child)
     {
         // add the child to the tree
-        node.addChild(&node, playerToMove, getChildNodeType(node, state), _actionVec, _params.maxChildren(), _memoryPool ? _memoryPool->alloc() : NULL);
+        node.addChild(&node, playerToMove, getChildNodeType(node, state), _actionVec);
         _results.nodesCreated++;
     }
 }
@@ -382,7 +801,8 @@ StateEvalScore UCTSearch::performPlayout(const GameState & state)
 
 const bool UCTSearch::isRoot(const UCTNode & node) const
 {
-    return &node == &_rootNode;
+    // compare node types rather than addresses so tree parallel threads recognize the shared root
+    return node.getNodeType() == SearchNodeType::RootNode;
 }
 
 void UCTSearch::printSubTree(const UCTNode & node, GameState s, std::string filename)
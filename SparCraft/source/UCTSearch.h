@@ -14,8 +14,11 @@
 #include "UCTNode.h"
 #include "GraphViz.hpp"
 #include "UCTMemoryPool.hpp"
+#include "UCTTranspositionTable.hpp"
 #include "Eval.h"
 #include <memory>
+#include <mutex>
+#include <atomic>
 
 namespace SparCraft
 {
@@ -30,6 +33,9 @@ class UCTSearch
 	Timer		            _searchTimer;
     UCTNode                 _rootNode;
     UCTMemoryPool *         _memoryPool;
+    std::shared_ptr<UCTMemoryPool> _ownedMemoryPool;    // used when no pool was set with setMemoryPool
+    UCTTranspositionTable * _transpositionTable;
+    std::shared_ptr<UCTTranspositionTable> _ownedTranspositionTable;    // used when no table was set with setTranspositionTable
 
     GameState               _currentState;
 
@@ -37,6 +43,7 @@ class UCTSearch
     Move                 _actionVec;
 	MoveArray                           _moveArray;
 	std::vector<Move>   _orderedMoves;
+    std::vector<UCTNode *>              _traversalPath;
 
     std::vector<PlayerPtr>				_allScripts[Players::Num_Players];
     PlayerPtr                           _playerModels[Players::Num_Players];
@@ -52,6 +59,15 @@ public:
 	void            uct(GameState & state, size_t depth, const size_t lastPlayerToMove, Move * firstSimMove);
 
 	void            doSearch(const GameState & initialState, Move & move);
+    void            runTraversals(const GameState & initialState, const size_t & maxTraversals);
+
+    // parallel search functions
+    void            doRootParallelSearch(const GameState & initialState, const size_t & numThreads);
+    void            doTreeParallelSearch(const GameState & initialState, const size_t & numThreads);
+    void            runSharedTraversals(const GameState & initialState, UCTNode & root, std::mutex & treeMutex, std::atomic<size_t> & traversalsLeft);
+    StateEvalScore  traverseShared(UCTNode & root, GameState & currentState, std::mutex & treeMutex);
+    void            mergeRootChildren(const UCTNode & root);
+    void            addThreadResults(const UCTSearchResults & threadResults);
     
     // Move and Child generation functions
     void            generateChildren(UCTNode & node, GameState & state);
@@ -69,7 +85,13 @@ public:
     const bool      isSecondSimMove(const UCTNode & node, GameState & state);
     StateEvalScore  performPlayout(const GameState & state);
     void            updateState(UCTNode & node, GameState & state, bool isLeaf);
+    void            updateStats(UCTNode & node, const StateEvalScore & playoutVal);
+    void            linkTransposition(UCTNode & node, const GameState & state);
+    const size_t    getNumThreads() const;
     void            setMemoryPool(UCTMemoryPool * pool);
+    UCTMemoryPool & getMemoryPool();
+    void            setTranspositionTable(UCTTranspositionTable * table);
+    UCTTranspositionTable * getTranspositionTable();
     UCTSearchResults & getResults();
 
     // graph printing functions
@@ -11,6 +11,11 @@ namespace SparCraft
     {
         enum { HighestValue,MostVisited };
     }
+
+    namespace UCTParallelMethod
+    {
+        enum { RootParallel, TreeParallel };
+    }
 }
 
 class SparCraft::UCTSearchParameters
@@ -27,6 +32,11 @@ class SparCraft::UCTSearchParameters
     PlayerPtr       _playoutPlayers[2];             //                      Players to use for playouts
     size_t		    _playerToMoveMethod;		    // Alternate			The player to move policy
     size_t		    _playerModel[2];                // None                 Player model to use for each player
+    size_t          _numThreads;                    // 1                    Number of search threads, 0 means one per hardware thread
+    size_t          _parallelMethod;                // RootParallel         How multiple search threads share the tree
+    size_t          _virtualLoss;                   // 1                    Visits added to a node while a TreeParallel thread is below it
+    bool            _useUndoLog;                    // true                 Roll back one working state instead of copying a state per traversal
+    size_t          _transpositionTableSize;        // 0                    Transposition table entries, 0 searches a tree instead of a DAG
 
     std::string     _graphVizFilename;              // ""                   File name to output graph viz file
 
@@ -47,6 +57,11 @@ public:
         ,_moveOrdering(MoveOrderMethod::ScriptFirst)
         ,_evalMethod(SparCraft::EvaluationMethods::Playout)
         ,_playerToMoveMethod(SparCraft::PlayerToMove::Alternate)
+        ,_numThreads(1)
+        ,_parallelMethod(UCTParallelMethod::RootParallel)
+        ,_virtualLoss(1)
+        ,_useUndoLog(true)
+        ,_transpositionTableSize(0)
     {
         setPlayerModel(Players::Player_One,PlayerModels::None);
         setPlayerModel(Players::Player_Two,PlayerModels::None);
@@ -65,6 +80,11 @@ public:
     const size_t & rootMoveSelectionMethod()                    const   { return _rootMoveSelection; }
     const std::string & graphVizFilename()                      const   { return _graphVizFilename; }
     const std::vector<size_t> & getOrderedMoveScripts()         const   { return _orderedMoveScripts; }
+    const size_t & numThreads()                                 const   { return _numThreads; }
+    const size_t & parallelMethod()                             const   { return _parallelMethod; }
+    const size_t & virtualLoss()                                const   { return _virtualLoss; }
+    const bool & useUndoLog()                                   const   { return _useUndoLog; }
+    const size_t & transpositionTableSize()                     const   { return _transpositionTableSize; }
 
     void setMaxPlayer(const size_t & player)					        { _maxPlayer = player; }
     void setTimeLimit(const size_t & timeLimit)					        { _timeLimit = timeLimit; }
@@ -79,6 +99,11 @@ public:
     void setGraphVizFilename(const std::string & filename)              { _graphVizFilename = filename; }
     void addOrderedMoveScript(const size_t & script)                    { _orderedMoveScripts.push_back(script); }
     void setPlayerModel(const size_t & player, const size_t & model)	{ _playerModel[player] = model; }
+    void setNumThreads(const size_t & threads)                          { _numThreads = threads; }
+    void setParallelMethod(const size_t & method)                       { _parallelMethod = method; }
+    void setVirtualLoss(const size_t & loss)                            { _virtualLoss = loss; }
+    void setUseUndoLog(const bool & useUndoLog)                         { _useUndoLog = useUndoLog; }
+    void setTranspositionTableSize(const size_t & size)                 { _transpositionTableSize = size; }
 
     std::vector<std::vector<std::string> > & getDescription()
     {
@@ -94,6 +119,8 @@ public:
             _desc[0].push_back("C Value:");
             _desc[0].push_back("Max Traversals:");
             _desc[0].push_back("Max Children:");
+            _desc[0].push_back("Threads:");
+            _desc[0].push_back("TT Size:");
             _desc[0].push_back("Move Ordering:");
             _desc[0].push_back("Player To Move:");
             _desc[0].push_back("Opponent Model:");
@@ -103,6 +130,8 @@ public:
             ss << cValue();                                             _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << maxTraversals();                                      _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << maxChildren();                                        _desc[1].push_back(ss.str()); ss.str(std::string());
+            ss << numThreads() << (parallelMethod() == UCTParallelMethod::TreeParallel ? " (Tree)" : " (Root)"); _desc[1].push_back(ss.str()); ss.str(std::string());
+            ss << transpositionTableSize();                             _desc[1].push_back(ss.str()); ss.str(std::string());
             //ss << MoveOrderMethod::getName(moveOrderingMethod());         _desc[1].push_back(ss.str()); ss.str(std::string());
             //ss << PlayerToMove::getName(playerToMoveMethod());            _desc[1].push_back(ss.str()); ss.str(std::string());
             //ss << PlayerModels::getName(playerModel((maxPlayer()+1)%2));  _desc[1].push_back(ss.str()); ss.str(std::string());
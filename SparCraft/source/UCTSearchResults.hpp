@@ -18,6 +18,9 @@ public:
     int                         nodesVisited;
     int                         totalVisits;
     int                         nodesCreated;
+    int                         transpositions;     // nodes that reached a position another node reached first
+
+    std::vector<int>            threadTraversals;   // traversals completed by each search thread
 
     Move     bestMoves;
 	double                   abValue;
@@ -32,6 +35,7 @@ public:
         , nodesVisited          (0)
         , totalVisits           (0)
         , nodesCreated          (0)
+        , transpositions        (0)
 		, abValue               (0)
 	{
 	}
@@ -48,11 +52,20 @@ public:
         _desc[0].push_back("Nodes Visited: ");
         _desc[0].push_back("Total Visits: ");
         _desc[0].push_back("Nodes Created: ");
+        _desc[0].push_back("Transpositions: ");
+        _desc[0].push_back("Thread Traversals: ");
 
         ss << traversals;       _desc[1].push_back(ss.str()); ss.str(std::string());
         ss << nodesVisited;     _desc[1].push_back(ss.str()); ss.str(std::string());
         ss << totalVisits;      _desc[1].push_back(ss.str()); ss.str(std::string());
         ss << nodesCreated;     _desc[1].push_back(ss.str()); ss.str(std::string());
+        ss << transpositions;   _desc[1].push_back(ss.str()); ss.str(std::string());
+
+        for (size_t t(0); t < threadTraversals.size(); ++t)
+        {
+            ss << (t > 0 ? " " : "") << threadTraversals[t];
+        }
+        _desc[1].push_back(ss.str()); ss.str(std::string());
         
         return _desc;
     }
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Common.h"
+#include <atomic>
+#include <memory>
+
+namespace SparCraft
+{
+    class UCTNode;
+    class UCTTranspositionEntry;
+    class UCTTranspositionTable;
+}
+
+// statistics shared by every UCT node that leads to the same position
+// the first node to reach the position becomes its canonical node, later nodes of the same tree
+// share its children, which turns the search tree into a DAG
+class SparCraft::UCTTranspositionEntry
+{
+public:
+
+    std::atomic<HashType>       key;            // position key, 0 while the entry is unused, see UCTTranspositionTable
+    std::atomic<size_t>         visits;         // visits through any node leading to the position
+    std::atomic<size_t>         halfWins;       // wins counted in halves, a draw is worth one
+    std::atomic<UCTNode *>      node;           // canonical node, its children are shared
+    std::atomic<const void *>   owner;          // tree the canonical node belongs to
+
+    UCTTranspositionEntry()
+        : key       (0)
+        , visits    (0)
+        , halfWins  (0)
+        , node      (nullptr)
+        , owner     (nullptr)
+    {
+    }
+
+    // resets the statistics, the key is left to the table
+    void clearStats()
+    {
+        visits.store(0, std::memory_order_relaxed);
+        halfWins.store(0, std::memory_order_relaxed);
+        node.store(nullptr, std::memory_order_relaxed);
+        owner.store(nullptr, std::memory_order_relaxed);
+    }
+
+    const double winRate() const
+    {
+        return (double)halfWins.load(std::memory_order_relaxed) / (2.0 * visits.load(std::memory_order_relaxed));
+    }
+};
+
+// lock-free open addressing table of UCTTranspositionEntry, keyed by the zobrist hash of the position
+// entries are claimed with a compare and swap on the key and are never removed during a search,
+// a position whose probe sequence is full simply isn't shared. clear() between searches, not during one
+// the top byte of a key is the generation of the search that claimed the entry, so clear() only starts a
+// new generation and entries of older ones are free to claim, the whole table is reset once every 255 searches
+class SparCraft::UCTTranspositionTable
+{
+    std::unique_ptr<UCTTranspositionEntry[]>    _entries;
+    size_t                                      _size;      // power of two
+    size_t                                      _mask;
+    HashType                                    _generation;
+
+    static const int        Generation_Shift = 56;
+    static const HashType   Max_Generation = 0xFF;
+    static const HashType   Busy_Key = 1;   // generation 0 is never current, marks an entry being claimed
+
+    const HashType generationOf(const HashType & key) const
+    {
+        return key >> Generation_Shift;
+    }
+
+public:
+
+    static const size_t Max_Probes = 8;     // entries tried after the home slot of a key
+
+    UCTTranspositionTable(const size_t & minSize = 65536)
+        : _size         (1)
+        , _generation   (1)
+    {
+        while (_size < minSize)
+        {
+            _size *= 2;
+        }
+
+        _mask = _size - 1;
+        _entries.reset(new UCTTranspositionEntry[_size]);
+    }
+
+    UCTTranspositionTable(const UCTTranspositionTable & table) = delete;
+    UCTTranspositionTable & operator = (const UCTTranspositionTable & table) = delete;
+
+    const size_t & size() const
+    {
+        return _size;
+    }
+
+    void clear()
+    {
+        if (++_generation <= Max_Generation)
+        {
+            return;
+        }
+
+        for (size_t i(0); i < _size; ++i)
+        {
+            _entries[i].key.store(0, std::memory_order_relaxed);
+            _entries[i].clearStats();
+        }
+
+        _generation = 1;
+    }
+
+    // returns the entry of the key, claiming an unused one if needed, or nullptr if none is free
+    UCTTranspositionEntry * find(const HashType & hash)
+    {
+        const HashType key = (_generation << Generation_Shift) | (hash & ((1ull << Generation_Shift) - 1));
+        size_t index = (size_t)hash & _mask;
+
+        for (size_t probe(0); probe <= Max_Probes; ++probe, index = (index + 1) & _mask)
+        {
+            UCTTranspositionEntry & entry = _entries[index];
+            HashType current = entry.key.load(std::memory_order_acquire);
+
+            // an entry left by an older search is reset before its key is published
+            if (current != Busy_Key && generationOf(current) != _generation
+                && entry.key.compare_exchange_strong(current, Busy_Key, std::memory_order_acq_rel))
+            {
+                entry.clearStats();
+                entry.key.store(key, std::memory_order_release);
+                return &entry;
+            }
+
+            // wait for another thread claiming the entry, it may be claiming it for our key
+            while (current == Busy_Key)
+            {
+                current = entry.key.load(std::memory_order_acquire);
+            }
+
+            // the entry is ours, or another thread claimed it for our key first
+            if (current == key)
+            {
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+};
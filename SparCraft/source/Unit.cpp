@@ -127,6 +127,12 @@ const Position & Unit::position() const
     return _position;
 }
 
+// position the unit started its current move from
+const Position & Unit::previousPosition() const
+{
+    return _previousPosition;
+}
+
 const HealthType Unit::damageTakenFrom(const Unit & attacker) const
 {
     const PlayerWeapon & weapon = attacker.getWeapon(*this);
@@ -80,6 +80,7 @@ public:
     // position related functions
 	const Position &        position()                  const;
 	const Position &        pos()                       const;
+	const Position &        previousPosition()          const;
 	const int      x()                         const;
 	const int      y()                         const;
 	const int      range()                     const;
@@ -1,5 +1,8 @@
 #include "Benchmarks.h"
 #include "Tournament.h"
+#include "ThroughputBenchmark.h"
+#include "../ConfigTools.h"
+#include "../Player_UCT.h"
 
 using namespace SparCraft;
 
@@ -39,6 +42,14 @@ void Benchmarks::DoBenchmarks(const std::string & filename)
         {
             DoTournamentBenchmark(benchmarks[b], document);
         }
+        else if (benchmarkType == "UndoLog")
+        {
+            DoUndoLogBenchmark(benchmarks[b], document);
+        }
+        else if (benchmarkType == "Throughput")
+        {
+            DoThroughputBenchmark(benchmarks[b], document);
+        }
         else
         {
             SPARCRAFT_ASSERT(false, "Unknown Benchmark type: %s", benchmarkType.c_str());
@@ -52,6 +63,59 @@ void Benchmarks::DoTournamentBenchmark(const rapidjson::Value & value, const rap
     tournament.run(value, rootValue);
 }
 
+void Benchmarks::DoThroughputBenchmark(const rapidjson::Value & value, const rapidjson::Value & rootValue)
+{
+    ThroughputBenchmark benchmark(value, rootValue);
+    benchmark.run();
+}
+
+// runs the same UCT searches copying the state every traversal and rolling back a single state
+// with the GameState undo log, and reports traversals per second for both
+void Benchmarks::DoUndoLogBenchmark(const rapidjson::Value & value, const rapidjson::Value & rootValue)
+{
+    std::string name, stateName, playerName;
+    size_t searches = 10;
+
+    JSONTools::ReadString("Name", value, name);
+    JSONTools::ReadString("State", value, stateName, true);
+    JSONTools::ReadString("Player", value, playerName, true);
+    JSONTools::ReadInt("Searches", value, searches);
+
+    GameState state = ConfigTools::GetStateFromVariable(stateName, rootValue);
+    PlayerPtr player = AIParameters::Instance().getPlayer(Players::Player_One, playerName);
+    Player_UCT * uctPlayer = dynamic_cast<Player_UCT *>(player.get());
+
+    SPARCRAFT_ASSERT(uctPlayer != nullptr, "UndoLog benchmark player must be a UCT player: %s", playerName.c_str());
+
+    printf("\nUndo Log Benchmark: %s (%s, %d searches)\n", name.c_str(), playerName.c_str(), (int)searches);
+
+    for (size_t undo(0); undo < 2; ++undo)
+    {
+        UCTSearchParameters params = uctPlayer->getParams();
+        params.setUseUndoLog(undo == 1);
+
+        // both runs search a plain tree, so neither pays for allocating and clearing a transposition table per search
+        params.setTranspositionTableSize(0);
+
+        UCTMemoryPool pool;
+        size_t traversals = 0;
+        double ms = 0;
+
+        for (size_t s(0); s < searches; ++s)
+        {
+            Move move;
+            UCTSearch search(params);
+            search.setMemoryPool(&pool);
+            search.doSearch(state, move);
+
+            traversals += search.getResults().traversals;
+            ms += search.getResults().timeElapsed;
+        }
+
+        printf("  %-12s %10d traversals %10.1lf ms %12.1lf traversals/sec\n", undo ? "Undo Log" : "State Copy", (int)traversals, ms, ms > 0 ? (1000.0 * traversals / ms) : 0.0);
+    }
+}
+
 //void Benchmarks::DoPlayerBenchmark(const PlayerBenchmark & benchmark)
 //{
 //    PlayerBenchmark b(benchmark);
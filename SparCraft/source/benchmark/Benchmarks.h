@@ -12,6 +12,8 @@ namespace Benchmarks
     void DoBenchmarks(const std::string & filename);
 
     void DoTournamentBenchmark(const rapidjson::Value & value, const rapidjson::Value & rootValue);
+    void DoUndoLogBenchmark(const rapidjson::Value & value, const rapidjson::Value & rootValue);
+    void DoThroughputBenchmark(const rapidjson::Value & value, const rapidjson::Value & rootValue);
     //void DoPlayerBenchmark(const PlayerBenchmark & benchmark);
 }
 
@@ -0,0 +1,351 @@
+#include "ThroughputBenchmark.h"
+#include "../Player_UCT.h"
+#include "../Player_PortfolioGreedySearch.h"
+
+#include <iomanip>
+#include <ctime>
+#include <sstream>
+#include <fstream>
+
+using namespace SparCraft;
+
+const size_t Army_Rows = 10;    // units per column of an army
+
+ThroughputBenchmark::ThroughputBenchmark(const rapidjson::Value & value, const rapidjson::Value & rootValue)
+    : _unitTypeName ("Protoss_Dragoon")
+    , _timeLimitMS  (1000)
+    , _maxTurns     (1000)
+{
+    JSONTools::ReadString("Name", value, _name);
+    JSONTools::ReadString("UnitType", value, _unitTypeName);
+    JSONTools::ReadString("OutputFile", value, _outputFile);
+    JSONTools::ReadInt("TimeLimitMS", value, _timeLimitMS);
+    JSONTools::ReadInt("MaxTurns", value, _maxTurns);
+
+    if (value.HasMember("ArmySizes"))
+    {
+        SPARCRAFT_ASSERT(value["ArmySizes"].IsArray(), "Throughput ArmySizes must be an array of ints");
+
+        for (size_t i(0); i < value["ArmySizes"].Size(); ++i)
+        {
+            _armySizes.push_back(value["ArmySizes"][i].GetInt());
+        }
+    }
+    else
+    {
+        _armySizes = { 4, 8, 16, 32, 64, 100 };
+    }
+
+    // without a list of scripts every script player of the config is measured
+    if (value.HasMember("Scripts"))
+    {
+        SPARCRAFT_ASSERT(value["Scripts"].IsArray(), "Throughput Scripts must be an array of player names");
+
+        for (size_t i(0); i < value["Scripts"].Size(); ++i)
+        {
+            _scripts.push_back(value["Scripts"][i].GetString());
+        }
+    }
+    else
+    {
+        const rapidjson::Value & players = rootValue["Players"];
+
+        for (auto it = players.MemberBegin(); it != players.MemberEnd(); ++it)
+        {
+            if (it->value.HasMember("Type") && std::string(it->value["Type"].GetString()) == "Script")
+            {
+                _scripts.push_back(it->name.GetString());
+            }
+        }
+    }
+
+    if (value.HasMember("SearchPlayers"))
+    {
+        SPARCRAFT_ASSERT(value["SearchPlayers"].IsArray(), "Throughput SearchPlayers must be an array of player names");
+
+        for (size_t i(0); i < value["SearchPlayers"].Size(); ++i)
+        {
+            _searchPlayers.push_back(value["SearchPlayers"][i].GetString());
+        }
+    }
+
+    SPARCRAFT_ASSERT(!_scripts.empty(), "Throughput benchmark needs at least one script player");
+}
+
+void ThroughputBenchmark::run()
+{
+    auto time = std::time(nullptr);
+    auto tm = *std::localtime(&time);
+
+    std::stringstream startDate;
+    startDate << std::put_time(&tm, "%Y-%m-%d_%H-%M-%S");
+    _date = startDate.str();
+
+    const BWAPI::UnitType type = BWAPI::UnitType::getType(_unitTypeName);
+    SPARCRAFT_ASSERT(System::UnitTypeSupported(type), "Throughput benchmark unit type not supported: %s", _unitTypeName.c_str());
+
+    rapidjson::StringBuffer buffer;
+    JSONWriter writer(buffer);
+
+    writer.StartObject();
+    writer.Key("Name");         writer.String(_name.c_str());
+    writer.Key("Date");         writer.String(_date.c_str());
+    writer.Key("Compiled");     writer.String(__DATE__ " " __TIME__);
+    writer.Key("UnitType");     writer.String(_unitTypeName.c_str());
+    writer.Key("TimeLimitMS");  writer.Uint64(_timeLimitMS);
+    writer.Key("MaxTurns");     writer.Uint64(_maxTurns);
+    writer.Key("Armies");
+    writer.StartArray();
+
+    printf("\nThroughput Benchmark: %s (%s, %dms per measurement)\n", _name.c_str(), _unitTypeName.c_str(), (int)_timeLimitMS);
+
+    for (const size_t & armySize : _armySizes)
+    {
+        const GameState state = getArmyState(type, armySize);
+
+        printf("\n  %dv%d\n", (int)armySize, (int)armySize);
+
+        writer.StartObject();
+        writer.Key("ArmySize");
+        writer.Uint64(armySize);
+
+        benchmarkStateCopy(state, writer);
+        benchmarkDoMove(state, writer);
+
+        writer.Key("Scripts");
+        writer.StartArray();
+        for (const std::string & script : _scripts)
+        {
+            benchmarkScript(state, script, writer);
+        }
+        writer.EndArray();
+
+        writer.Key("Searches");
+        writer.StartArray();
+        for (const std::string & search : _searchPlayers)
+        {
+            benchmarkSearch(state, search, writer);
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+
+    if (_outputFile.size() > 0)
+    {
+        std::ofstream fout(_outputFile.c_str());
+        SPARCRAFT_ASSERT(fout.good(), "Couldn't open Throughput output file: %s", _outputFile.c_str());
+
+        fout << buffer.GetString() << std::endl;
+        printf("\n  Results written to %s\n", _outputFile.c_str());
+    }
+    else
+    {
+        std::cout << buffer.GetString() << std::endl;
+    }
+}
+
+// two mirrored armies in columns facing each other, out of range of each other so playouts include moving
+GameState ThroughputBenchmark::getArmyState(const BWAPI::UnitType & type, const size_t & armySize) const
+{
+    const int spacing = 8 + std::max(type.dimensionLeft() + type.dimensionRight(), type.dimensionUp() + type.dimensionDown());
+    const int centerY = 640;
+    const int frontX[2] = { 640 - type.groundWeapon().maxRange() - 64, 640 + type.groundWeapon().maxRange() + 64 };
+    const int direction[2] = { -1, 1 };
+
+    GameState state;
+    for (size_t u(0); u < armySize; ++u)
+    {
+        const int col = (int)(u / Army_Rows);
+        const int row = (int)(u % Army_Rows);
+        const int y = centerY + (row - (int)Army_Rows / 2) * spacing;
+
+        for (size_t p(0); p < Players::Num_Players; ++p)
+        {
+            state.addUnit(Unit(type, p, Position(frontX[p] + direction[p] * col * spacing, y)));
+        }
+    }
+
+    return state;
+}
+
+void ThroughputBenchmark::benchmarkStateCopy(const GameState & state, JSONWriter & writer)
+{
+    size_t copies = 0;
+    size_t checksum = 0;
+
+    Timer t;
+    t.start();
+
+    while (t.getElapsedTimeInMilliSec() < _timeLimitMS)
+    {
+        for (size_t i(0); i < 256; ++i)
+        {
+            GameState copy(state);
+            checksum += copy.numUnits(Players::Player_One);
+        }
+
+        copies += 256;
+    }
+
+    const double ms = t.getElapsedTimeInMilliSec();
+    const double nsPerCopy = 1000000.0 * ms / copies;
+
+    printf("    %-24s %12.1lf ns/copy   %14.0lf copies/sec\n", "GameState Copy", nsPerCopy, 1000.0 * copies / ms);
+
+    writer.Key("StateCopy");
+    writer.StartObject();
+    writer.Key("Copies");       writer.Uint64(copies);
+    writer.Key("NSPerCopy");    writer.Double(nsPerCopy);
+    writer.Key("CopiesPerSec"); writer.Double(1000.0 * copies / ms);
+    writer.Key("Checksum");     writer.Uint64(checksum);
+    writer.EndObject();
+}
+
+// records the moves of a game between the first script and itself, then times replaying them
+// so only GameState::doMove is measured and not the move generation of the scripts
+void ThroughputBenchmark::benchmarkDoMove(const GameState & state, JSONWriter & writer)
+{
+    std::vector<Move> moves[2];
+
+    PlayerPtr players[2] = { AIParameters::Instance().getPlayer(Players::Player_One, _scripts[0]),
+                             AIParameters::Instance().getPlayer(Players::Player_Two, _scripts[0]) };
+
+    GameState recordState(state);
+    while (!recordState.gameOver() && moves[0].size() < _maxTurns)
+    {
+        const size_t whoCanMove = recordState.whoCanMove();
+
+        Move turnMoves[2];
+        for (size_t p(0); p < Players::Num_Players; ++p)
+        {
+            if (whoCanMove == Players::Player_Both || whoCanMove == p)
+            {
+                players[p]->getMove(recordState, turnMoves[p]);
+            }
+
+            moves[p].push_back(turnMoves[p]);
+        }
+
+        recordState.doMove(turnMoves[0], turnMoves[1]);
+    }
+
+    size_t doMoves = 0;
+
+    Timer t;
+    t.start();
+
+    while (t.getElapsedTimeInMilliSec() < _timeLimitMS)
+    {
+        GameState replayState(state);
+
+        for (size_t m(0); m < moves[0].size(); ++m)
+        {
+            replayState.doMove(moves[0][m], moves[1][m]);
+        }
+
+        doMoves += moves[0].size();
+    }
+
+    const double ms = t.getElapsedTimeInMilliSec();
+
+    printf("    %-24s %12.1lf ns/doMove %14.0lf doMoves/sec\n", "GameState doMove", 1000000.0 * ms / doMoves, 1000.0 * doMoves / ms);
+
+    writer.Key("DoMove");
+    writer.StartObject();
+    writer.Key("Player");       writer.String(_scripts[0].c_str());
+    writer.Key("GameTurns");    writer.Uint64(moves[0].size());
+    writer.Key("DoMoves");      writer.Uint64(doMoves);
+    writer.Key("DoMovesPerSec"); writer.Double(1000.0 * doMoves / ms);
+    writer.EndObject();
+}
+
+// full games of a script against itself
+void ThroughputBenchmark::benchmarkScript(const GameState & state, const std::string & playerName, JSONWriter & writer)
+{
+    PlayerPtr players[2] = { AIParameters::Instance().getPlayer(Players::Player_One, playerName),
+                             AIParameters::Instance().getPlayer(Players::Player_Two, playerName) };
+
+    size_t playouts = 0;
+    size_t turns = 0;
+
+    Timer t;
+    t.start();
+
+    while (t.getElapsedTimeInMilliSec() < _timeLimitMS)
+    {
+        Game game(state, players[0], players[1], _maxTurns);
+        game.play();
+
+        playouts++;
+        turns += game.getRounds();
+    }
+
+    const double ms = t.getElapsedTimeInMilliSec();
+
+    printf("    %-24s %12.1lf playouts/sec %10.0lf turns/sec\n", playerName.c_str(), 1000.0 * playouts / ms, 1000.0 * turns / ms);
+
+    writer.StartObject();
+    writer.Key("Player");           writer.String(playerName.c_str());
+    writer.Key("Playouts");         writer.Uint64(playouts);
+    writer.Key("Turns");            writer.Uint64(turns);
+    writer.Key("PlayoutsPerSec");   writer.Double(1000.0 * playouts / ms);
+    writer.Key("TurnsPerSec");      writer.Double(1000.0 * turns / ms);
+    writer.EndObject();
+}
+
+// repeated searches from the initial state, UCT reports the nodes it creates and PGS the playouts it evaluates
+void ThroughputBenchmark::benchmarkSearch(const GameState & state, const std::string & playerName, JSONWriter & writer)
+{
+    PlayerPtr player = AIParameters::Instance().getPlayer(Players::Player_One, playerName);
+    Player_UCT * uctPlayer = dynamic_cast<Player_UCT *>(player.get());
+    Player_PortfolioGreedySearch * pgsPlayer = dynamic_cast<Player_PortfolioGreedySearch *>(player.get());
+
+    SPARCRAFT_ASSERT(uctPlayer || pgsPlayer, "Throughput search player must be a UCT or PGS player: %s", playerName.c_str());
+
+    size_t searches = 0;
+    size_t nodes = 0;
+    UCTMemoryPool pool;
+
+    Timer t;
+    t.start();
+
+    while (t.getElapsedTimeInMilliSec() < _timeLimitMS)
+    {
+        if (uctPlayer)
+        {
+            Move move;
+            UCTSearch search(uctPlayer->getParams());
+            search.setMemoryPool(&pool);
+            search.doSearch(state, move);
+
+            nodes += search.getResults().nodesCreated;
+        }
+        else
+        {
+            PortfolioGreedySearch search(pgsPlayer->getParams());
+            search.search(state, Players::Player_One);
+
+            nodes += search.getNumPlayouts();
+        }
+
+        searches++;
+    }
+
+    const double ms = t.getElapsedTimeInMilliSec();
+    const char * nodeName = uctPlayer ? "nodes" : "playouts";
+
+    printf("    %-24s %12.1lf searches/sec %10.0lf %s/sec\n", playerName.c_str(), 1000.0 * searches / ms, 1000.0 * nodes / ms, nodeName);
+
+    writer.StartObject();
+    writer.Key("Player");           writer.String(playerName.c_str());
+    writer.Key("Search");           writer.String(uctPlayer ? "UCT" : "PGS");
+    writer.Key("Searches");         writer.Uint64(searches);
+    writer.Key("Nodes");            writer.Uint64(nodes);
+    writer.Key("SearchesPerSec");   writer.Double(1000.0 * searches / ms);
+    writer.Key("NodesPerSec");      writer.Double(1000.0 * nodes / ms);
+    writer.EndObject();
+}
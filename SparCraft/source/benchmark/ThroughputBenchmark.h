@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../SparCraft.h"
+#include "../rapidjson/document.h"
+#include "../rapidjson/prettywriter.h"
+#include "../rapidjson/stringbuffer.h"
+
+namespace SparCraft
+{
+
+typedef rapidjson::PrettyWriter<rapidjson::StringBuffer> JSONWriter;
+
+// raw speed of the engine and the players on mirrored armies of increasing size
+// every measurement repeats its operation until the time limit is up and reports a rate,
+// the results are printed and written as JSON so they can be compared between builds
+class ThroughputBenchmark
+{
+    std::string                 _name;
+    std::string                 _date;
+    std::string                 _unitTypeName;
+    std::string                 _outputFile;
+    size_t                      _timeLimitMS;
+    size_t                      _maxTurns;          // turn limit of played games, scripts that hold position never finish
+    std::vector<size_t>         _armySizes;
+    std::vector<std::string>    _scripts;
+    std::vector<std::string>    _searchPlayers;
+
+    GameState                   getArmyState(const BWAPI::UnitType & type, const size_t & armySize) const;
+    void                        benchmarkStateCopy(const GameState & state, JSONWriter & writer);
+    void                        benchmarkDoMove(const GameState & state, JSONWriter & writer);
+    void                        benchmarkScript(const GameState & state, const std::string & playerName, JSONWriter & writer);
+    void                        benchmarkSearch(const GameState & state, const std::string & playerName, JSONWriter & writer);
+
+public:
+
+    ThroughputBenchmark(const rapidjson::Value & value, const rapidjson::Value & rootValue);
+
+    void run();
+};
+
+}
@@ -5,12 +5,58 @@
 #include <iomanip>
 #include <ctime>
 #include <sstream>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
 
 using namespace SparCraft;
 
+TournamentResults::TournamentResults(const size_t & numPlayers)
+    : totalGamesPlayed  (0)
+    , totalGames        (numPlayers, 0)
+    , totalWins         (numPlayers, 0)
+    , totalDraws        (numPlayers, 0)
+    , totalPlayouts     (numPlayers, 0)
+    , totalTurns        (numPlayers, 0)
+    , maxTimeMS         (numPlayers, 0)
+    , totalTimeMS       (numPlayers, 0)
+    , numGames          (numPlayers, std::vector<int>(numPlayers, 0))
+    , wins              (numPlayers, std::vector<int>(numPlayers, 0))
+    , draws             (numPlayers, std::vector<int>(numPlayers, 0))
+    , turns             (numPlayers, std::vector<int>(numPlayers, 0))
+{
+
+}
+
+void TournamentResults::add(const TournamentResults & results)
+{
+    totalGamesPlayed += results.totalGamesPlayed;
+
+    for (size_t p(0); p < totalGames.size(); ++p)
+    {
+        totalGames[p]       += results.totalGames[p];
+        totalWins[p]        += results.totalWins[p];
+        totalDraws[p]       += results.totalDraws[p];
+        totalPlayouts[p]    += results.totalPlayouts[p];
+        totalTurns[p]       += results.totalTurns[p];
+        totalTimeMS[p]      += results.totalTimeMS[p];
+        maxTimeMS[p]        = std::max(maxTimeMS[p], results.maxTimeMS[p]);
+
+        for (size_t q(0); q < totalGames.size(); ++q)
+        {
+            numGames[p][q]  += results.numGames[p][q];
+            wins[p][q]      += results.wins[p][q];
+            draws[p][q]     += results.draws[p][q];
+            turns[p][q]     += results.turns[p][q];
+        }
+    }
+}
+
 Tournament::Tournament()
-    : _totalGamesPlayed(0)
-    , _updateIntervalSec(0)
+    : _updateIntervalSec(0)
+    , _threads(1)
+    , _nextGame(0)
+    , _rootValue(nullptr)
 {
     
 }
@@ -25,6 +71,7 @@ void Tournament::run(const rapidjson::Value & tournamentValue, const rapidjson::
     JSONTools::ReadInt("Rounds", tournamentValue, _rounds);
     JSONTools::ReadString("State", tournamentValue, _stateName);
     JSONTools::ReadInt("UpdateIntervalSec", tournamentValue, _updateIntervalSec);
+    JSONTools::ReadInt("Threads", tournamentValue, _threads);
 
     SPARCRAFT_ASSERT(tournamentValue["Players"].Size() >= 2, "Tournament has less than 2 players");
 
@@ -41,94 +88,200 @@ void Tournament::run(const rapidjson::Value & tournamentValue, const rapidjson::
     startDate << std::put_time(&tm, "%Y-%m-%d_%H-%M-%S");
     _date = startDate.str();
 
-    _totalGames = std::vector<int>(_players.size(), 0);
-    _totalWins = std::vector<int>(_players.size(), 0);
-    _totalDraws = std::vector<int>(_players.size(), 0);
-    _totalTurns = std::vector<int>(_players.size(), 0);
-    _totalPlayouts = std::vector<int>(_players.size(), 0);
-    _totalTimeMS = std::vector<int>(_players.size(), 0);
-    _maxTimeMS = std::vector<int>(_players.size(), 0);
-    _numGames = std::vector< std::vector<int> >(_players.size(), std::vector<int>(_players.size(), 0));
-    _wins = std::vector< std::vector<int> >(_players.size(), std::vector<int>(_players.size(), 0));
-    _draws = std::vector< std::vector<int> >(_players.size(), std::vector<int>(_players.size(), 0));
-    _turns = std::vector< std::vector<int> >(_players.size(), std::vector<int>(_players.size(), 0));
+    _results = TournamentResults(_players.size());
+
+    // every pair of players from different groups plays each round, once as each side
+    for (size_t p1(0); p1 < _players.size(); ++p1)
+    {
+        for (size_t p2(0); p2 < _players.size(); ++p2)
+        {
+            if (_playerGroups[p1] != _playerGroups[p2])
+            {
+                _pairings.push_back(std::pair<size_t, size_t>(p1, p2));
+            }
+        }
+    }
+
+    _rootValue = &rootValue;
+    _nextGame = 0;
+    _timeElapsed.start();
+
+    const size_t numThreads = _threads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : _threads;
+
+    if (numThreads <= 1)
+    {
+        runSerial();
+    }
+    else
+    {
+        runParallel(numThreads);
+    }
+
+    printResults(_results);
+    writeHTMLResults(_results);
+}
+
+// returns the next game to be played, or null once every game of the tournament has been handed out
+// the state of a round is generated when its first game is handed out, so the states are the same
+// as in a single threaded tournament
+std::shared_ptr<TournamentGame> Tournament::getNextGame()
+{
+    std::lock_guard<std::mutex> lock(_scheduleMutex);
+
+    const size_t gamesPerRound = 2 * _pairings.size();
+    if (_nextGame >= _rounds * gamesPerRound)
+    {
+        return std::shared_ptr<TournamentGame>();
+    }
+
+    const size_t game = _nextGame++;
+
+    if (game % gamesPerRound == 0)
+    {
+        _roundState = ConfigTools::GetStateFromVariable(_stateName, *_rootValue);
+    }
 
+    const std::pair<size_t, size_t> & pairing = _pairings[(game % gamesPerRound) / 2];
+    const size_t p1 = (game % 2 == 0) ? pairing.first : pairing.second;
+    const size_t p2 = (game % 2 == 0) ? pairing.second : pairing.first;
+
+    PlayerPtr white = AIParameters::Instance().getPlayer(Players::Player_One, _players[p1]);
+    PlayerPtr black = AIParameters::Instance().getPlayer(Players::Player_Two, _players[p2]);
+
+    return std::make_shared<TournamentGame>(_roundState, _players[p1], white, _players[p2], black);
+}
+
+void Tournament::runSerial()
+{
     Timer t;
     t.start();
-    _timeElapsed.start();
 
-    for (size_t r(0); r < _rounds; ++r)
+    std::shared_ptr<TournamentGame> game;
+    while (game = getNextGame())
     {
-        GameState state = ConfigTools::GetStateFromVariable(_stateName, rootValue);
+        game->playGame();
+        parseTournamentGameResult(*game, _results);
 
-        for (size_t p1(0); p1 < _players.size(); ++p1)
+        if (t.getElapsedTimeInSec() > _updateIntervalSec)
         {
-            for (size_t p2(0); p2 < _players.size(); ++p2)
+            printResults(_results);
+            writeHTMLResults(_results);
+            printf("\n\n");
+            t.start();
+        }
+    }
+}
+
+// plays the games on a pool of threads, each thread counts the results of its games on its own
+// the periodic output sums the threads' results, each of which is locked while it is read, so a
+// snapshot contains every counter of a game or none of them
+void Tournament::runParallel(const size_t & numThreads)
+{
+    std::vector<TournamentResults> threadResults(numThreads, TournamentResults(_players.size()));
+    std::vector<std::mutex> threadResultMutexes(numThreads);
+    std::vector<std::exception_ptr> threadExceptions(numThreads);
+    std::vector<std::thread> threads;
+
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    size_t threadsDone = 0;
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads.push_back(std::thread([&, t]()
+        {
+            try
             {
-                if (_playerGroups[p1] == _playerGroups[p2])
+                std::shared_ptr<TournamentGame> game;
+                while (game = getNextGame())
                 {
-                    continue;
+                    game->playGame();
+
+                    std::lock_guard<std::mutex> lock(threadResultMutexes[t]);
+                    parseTournamentGameResult(*game, threadResults[t]);
                 }
+            }
+            catch (...)
+            {
+                threadExceptions[t] = std::current_exception();
+
+                // stop handing out games so the other threads finish
+                std::lock_guard<std::mutex> lock(_scheduleMutex);
+                _nextGame = _rounds * 2 * _pairings.size();
+            }
 
-                PlayerPtr w1 = AIParameters::Instance().getPlayer(Players::Player_One, _players[p1]);
-                PlayerPtr b1 = AIParameters::Instance().getPlayer(Players::Player_Two, _players[p2]);
-                PlayerPtr w2 = AIParameters::Instance().getPlayer(Players::Player_One, _players[p2]);
-                PlayerPtr b2 = AIParameters::Instance().getPlayer(Players::Player_Two, _players[p1]);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            threadsDone++;
+            doneCondition.notify_all();
+        }));
+    }
 
-                TournamentGame g1(state, _players[p1], w1, _players[p2], b1);
-                TournamentGame g2(state, _players[p2], w2, _players[p1], b2);
+    const std::chrono::seconds updateInterval(std::max(_updateIntervalSec, (size_t)1));
 
-                playGame(g1);
-                playGame(g2);
+    std::unique_lock<std::mutex> doneLock(doneMutex);
+    while (!doneCondition.wait_for(doneLock, updateInterval, [&]() { return threadsDone == numThreads; }))
+    {
+        doneLock.unlock();
 
-                if (t.getElapsedTimeInSec() > _updateIntervalSec)
-                {
-                    printResults();
-                    writeHTMLResults();
-                    printf("\n\n");
-                    t.start();
-                }
-            }
+        TournamentResults snapshot(_players.size());
+        for (size_t t(0); t < numThreads; ++t)
+        {
+            std::lock_guard<std::mutex> lock(threadResultMutexes[t]);
+            snapshot.add(threadResults[t]);
         }
+
+        printResults(snapshot);
+        writeHTMLResults(snapshot);
+        printf("\n\n");
+
+        doneLock.lock();
     }
-}
+    doneLock.unlock();
 
-void Tournament::playGame(TournamentGame & game)
-{
-    game.playGame();
-    parseTournamentGameResult(game);
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads[t].join();
+    }
 
-    _totalGamesPlayed++;
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        if (threadExceptions[t])
+        {
+            std::rethrow_exception(threadExceptions[t]);
+        }
+
+        _results.add(threadResults[t]);
+    }
 }
 
-void Tournament::parseTournamentGameResult(const TournamentGame & game)
+void Tournament::parseTournamentGameResult(const TournamentGame & game, TournamentResults & results)
 {
     int winnerID = game.getFinalGameState().winner();
     int loserID = (game.getFinalGameState().winner() + 1) % 2;
 
     int playerIndex[2] = {getPlayerIndex(game.getPlayerName(0)), getPlayerIndex(game.getPlayerName(1))};
 
-    _maxTimeMS[playerIndex[0]] = std::max(_maxTimeMS[playerIndex[0]], (int)game.getMaxTimeMS(0));
-    _maxTimeMS[playerIndex[1]] = std::max(_maxTimeMS[playerIndex[1]], (int)game.getMaxTimeMS(1));
-    _totalTimeMS[playerIndex[0]] += game.getTotalTimeMS(0);
-    _totalTimeMS[playerIndex[1]] += game.getTotalTimeMS(1);
-    _totalGames[playerIndex[0]]++;
-    _totalGames[playerIndex[1]]++;
-    _numGames[playerIndex[0]][playerIndex[1]]++;
-    _numGames[playerIndex[1]][playerIndex[0]]++;
-    _totalTurns[playerIndex[0]] += game.getTotalMoves(0);
-    _totalTurns[playerIndex[1]] += game.getTotalMoves(1);
-    _turns[playerIndex[0]][playerIndex[1]] += game.getTotalMoves(0) + game.getTotalMoves(1);
-    _turns[playerIndex[1]][playerIndex[0]] += game.getTotalMoves(0) + game.getTotalMoves(1);
+    results.maxTimeMS[playerIndex[0]] = std::max(results.maxTimeMS[playerIndex[0]], (int)game.getMaxTimeMS(0));
+    results.maxTimeMS[playerIndex[1]] = std::max(results.maxTimeMS[playerIndex[1]], (int)game.getMaxTimeMS(1));
+    results.totalTimeMS[playerIndex[0]] += game.getTotalTimeMS(0);
+    results.totalTimeMS[playerIndex[1]] += game.getTotalTimeMS(1);
+    results.totalGames[playerIndex[0]]++;
+    results.totalGames[playerIndex[1]]++;
+    results.numGames[playerIndex[0]][playerIndex[1]]++;
+    results.numGames[playerIndex[1]][playerIndex[0]]++;
+    results.totalTurns[playerIndex[0]] += game.getTotalMoves(0);
+    results.totalTurns[playerIndex[1]] += game.getTotalMoves(1);
+    results.turns[playerIndex[0]][playerIndex[1]] += game.getTotalMoves(0) + game.getTotalMoves(1);
+    results.turns[playerIndex[1]][playerIndex[0]] += game.getTotalMoves(0) + game.getTotalMoves(1);
 
 
     // case of a draw
     if (winnerID == Players::Player_None)
     {
-        _draws[playerIndex[0]][playerIndex[1]]++;
-        _draws[playerIndex[1]][playerIndex[0]]++;
-        _totalDraws[playerIndex[0]]++;
-        _totalDraws[playerIndex[1]]++;
+        results.draws[playerIndex[0]][playerIndex[1]]++;
+        results.draws[playerIndex[1]][playerIndex[0]]++;
+        results.totalDraws[playerIndex[0]]++;
+        results.totalDraws[playerIndex[1]]++;
     }
     else
     {
@@ -136,13 +289,15 @@ void Tournament::parseTournamentGameResult(const TournamentGame & game)
         int winnerIndex = playerIndex[winnerID];
         int loserIndex = playerIndex[loserID];
 
-        _totalWins[winnerIndex]++;
-        _wins[winnerIndex][loserIndex]++;
+        results.totalWins[winnerIndex]++;
+        results.wins[winnerIndex][loserIndex]++;
     }
+
+    results.totalGamesPlayed++;
 }
 
 #include "../htmltools/HTMLTable.h"
-void Tournament::writeHTMLResults()
+void Tournament::writeHTMLResults(const TournamentResults & results)
 {
     std::string filename = "html/Tournament_" + _name + "_" + _date + ".html";
         
@@ -155,7 +310,7 @@ void Tournament::writeHTMLResults()
     ss << "<tr><td><b>AI Compiled</b></td><td align=right>" << __DATE__ << " " __TIME__ << "</td></tr>";
     ss << "<tr><td><b>Tournament Rounds</b></td><td align=right>" << _rounds << "</td></tr>\n";
     ss << "<tr><td><b>Time Elapsed</b></td><td align=right>" << getTimeStringFromMS(timeElapsed) << "</td></tr>\n";
-    ss << "<tr><td><b>Games Played</b></td><td align=right>" << _totalGamesPlayed << " (" << (1000.0 * _totalGamesPlayed / timeElapsed) << "/s)</td></tr>\n";
+    ss << "<tr><td><b>Games Played</b></td><td align=right>" << results.totalGamesPlayed << " (" << (1000.0 * results.totalGamesPlayed / timeElapsed) << "/s)</td></tr>\n";
     ss << "</table>\n<br><br>\n";
 
     FILE * f = fopen(filename.c_str(), "w");
@@ -173,15 +328,15 @@ void Tournament::writeHTMLResults()
     {
         size_t col = 0;
         stats.setData(p, col++, _players[p]);
-        stats.setData(p, col++, (_totalWins[p] + 0.5*_totalDraws[p])/_totalGames[p]);
-        stats.setData(p, col++, _totalGames[p]);
-        stats.setData(p, col++, _totalWins[p]);
-        stats.setData(p, col++, _totalGames[p] - _totalWins[p] - _totalDraws[p]);
-        stats.setData(p, col++, _totalDraws[p]);
-        stats.setData(p, col++, _totalTurns[p]);
-        stats.setData(p, col++, (double)_totalTurns[p] / _totalGames[p]);
-        stats.setData(p, col++, (double)_totalTimeMS[p] / _totalTurns[p]);
-        stats.setData(p, col++, _maxTimeMS[p]);
+        stats.setData(p, col++, (results.totalWins[p] + 0.5*results.totalDraws[p])/results.totalGames[p]);
+        stats.setData(p, col++, results.totalGames[p]);
+        stats.setData(p, col++, results.totalWins[p]);
+        stats.setData(p, col++, results.totalGames[p] - results.totalWins[p] - results.totalDraws[p]);
+        stats.setData(p, col++, results.totalDraws[p]);
+        stats.setData(p, col++, results.totalTurns[p]);
+        stats.setData(p, col++, (double)results.totalTurns[p] / results.totalGames[p]);
+        stats.setData(p, col++, (double)results.totalTimeMS[p] / results.totalTurns[p]);
+        stats.setData(p, col++, results.maxTimeMS[p]);
     }
 
     HTMLTable turnTable("Bot vs. Bot Avg Turns Per Game");
@@ -212,15 +367,15 @@ void Tournament::writeHTMLResults()
             }
             else
             {
-                turnTable.setData(r, col, _numGames[r][p] == 0 ? 0 : (double)_turns[r][p] / _numGames[r][p]);
-                tableWinPerc.setData(r, col, _numGames[r][p] == 0 ? 0 : ((double)_wins[r][p] + 0.5*_draws[r][p]) / _numGames[r][p]);
+                turnTable.setData(r, col, results.numGames[r][p] == 0 ? 0 : (double)results.turns[r][p] / results.numGames[r][p]);
+                tableWinPerc.setData(r, col, results.numGames[r][p] == 0 ? 0 : ((double)results.wins[r][p] + 0.5*results.draws[r][p]) / results.numGames[r][p]);
             }
 
             col++;
         }
 
-        turnTable.setData(r, col, _totalTurns[r]);
-        tableWinPerc.setData(r, col, _totalGames[r] == 0 ? 0 : ((double)_totalWins[r] + 0.5*_totalDraws[r]) / _totalGames[r]);
+        turnTable.setData(r, col, results.totalTurns[r]);
+        tableWinPerc.setData(r, col, results.totalGames[r] == 0 ? 0 : ((double)results.totalWins[r] + 0.5*results.totalDraws[r]) / results.totalGames[r]);
         col++;
     }
 
@@ -229,7 +384,7 @@ void Tournament::writeHTMLResults()
     turnTable.appendHTMLTableToFile(filename, "totalScoreTable");
 }
 
-void Tournament::printResults() const
+void Tournament::printResults(const TournamentResults & results) const
 {
     std::stringstream ss;
   
@@ -263,7 +418,7 @@ void Tournament::printResults() const
         {
             if (_playerGroups[i] != _playerGroups[j])
             {
-                line << _wins[i][j] + (0.5*_draws[i][j]) ;
+                line << results.wins[i][j] + (0.5*results.draws[i][j]) ;
             }
             else
             {
@@ -273,7 +428,7 @@ void Tournament::printResults() const
             while (line.str().length() < colWidth + (j+1)*colWidth) line << " ";
         }
 
-        line << (_totalWins[i] + (0.5*_totalDraws[i]))/_totalGames[i];
+        line << (results.totalWins[i] + (0.5*results.totalDraws[i]))/results.totalGames[i];
         line << std::endl;
         ss << line.str();
         std::cout << line.str();
@@ -3,10 +3,36 @@
 #include "../SparCraft.h"
 #include "../rapidjson/document.h"
 #include "TournamentGame.h"
+#include <mutex>
+#include <memory>
 
 namespace SparCraft
 {
  
+// result counters of a set of tournament games
+// every worker thread of a multi-threaded tournament fills its own, and they are summed for output
+class TournamentResults
+{
+public:
+
+    size_t                              totalGamesPlayed;
+    std::vector<int>                    totalGames;
+    std::vector<int>                    totalWins;
+    std::vector<int>                    totalDraws;
+    std::vector<int>                    totalPlayouts;
+    std::vector<int>                    totalTurns;
+    std::vector<int>                    maxTimeMS;
+    std::vector<int>                    totalTimeMS;
+    std::vector< std::vector<int> >     numGames;
+    std::vector< std::vector<int> >     wins;
+    std::vector< std::vector<int> >     draws;
+    std::vector< std::vector<int> >     turns;
+
+    TournamentResults(const size_t & numPlayers = 0);
+
+    void add(const TournamentResults & results);
+};
+
 class Tournament
 {
     std::string                         _name;
@@ -14,31 +40,30 @@ class Tournament
     std::string                         _date;
     std::string                         _stateName;
     size_t                              _rounds;
-    size_t                              _totalGamesPlayed;
     size_t                              _updateIntervalSec;
+    size_t                              _threads;
     Timer                               _timeElapsed;
 
     std::vector<std::string>            _players;
     std::vector<std::string>            _stateDescriptions;
     std::vector<int>                    _playerGroups;
-    std::vector<int>                    _totalGames;
-    std::vector<int>                    _totalWins;
-    std::vector<int>                    _totalDraws;
-    std::vector<int>                    _totalPlayouts;
-    std::vector<int>                    _totalTurns;
-    std::vector<int>                    _maxTimeMS;
-    std::vector<int>                    _totalTimeMS;
-    std::vector< std::vector<int> >     _numGames;
-    std::vector< std::vector<int> >     _wins;
-    std::vector< std::vector<int> >     _draws;
-    std::vector< std::vector<int> >     _turns;
+    TournamentResults                   _results;
+
+    // game scheduling, games are handed out in the order a single threaded tournament plays them
+    std::mutex                          _scheduleMutex;
+    std::vector< std::pair<size_t, size_t> > _pairings;
+    size_t                              _nextGame;
+    GameState                           _roundState;
+    const rapidjson::Value *            _rootValue;
 
     int getPlayerIndex(const std::string & playerName) const;
     void parseResult(std::string & result);
-    void parseTournamentGameResult(const TournamentGame & game);
-    void playGame(TournamentGame & game);
-    void writeHTMLResults();
-    void printResults() const;
+    void parseTournamentGameResult(const TournamentGame & game, TournamentResults & results);
+    std::shared_ptr<TournamentGame> getNextGame();
+    void runSerial();
+    void runParallel(const size_t & numThreads);
+    void writeHTMLResults(const TournamentResults & results);
+    void printResults(const TournamentResults & results) const;
     std::string getTimeStringFromMS(const size_t ms);
 
 public:
@@ -5,9 +5,13 @@
 
 using namespace UAlbertaBot;
 
+// the search thread steps the search in slices this long so a cancel is noticed quickly
+const double SearchThreadSliceMicros = 2000;
+
 // constructor
 BOSSManager::BOSSManager(
 	shared_ptr<AKBot::OpponentView> opponentView,
+	const BotMacroConfiguration& macroConfiguration,
 	const BotDebugConfiguration& debugConfiguration)
 	: _opponentView(opponentView)
 	, _previousSearchStartFrame(0)
@@ -15,12 +19,28 @@ BOSSManager::BOSSManager(
     , _searchInProgress(false)
     , _previousStatus("No Searches")
 	, _debugConfiguration(debugConfiguration)
+	, _hasExceptionDuringSearch(false)
+	, _noSolutionFound(false)
+	, _bossFrameLimit(macroConfiguration.BOSSFrameLimit)
+	, _useSearchThread(macroConfiguration.BOSSSearchThread)
+	, _searchThreadDone(false)
+	, _cancelSearchThread(false)
+	, _searchThreadTime(0)
 {
-	
+    // build orders kept by earlier games are read from the read directory, this game's are written to
+    // the write directory. without a cache file every goal is searched for
+    _buildOrderCache.openCopy(macroConfiguration.BOSSCacheReadFile, macroConfiguration.BOSSCacheWriteFile);
+}
+
+BOSSManager::~BOSSManager()
+{
+    stopSearchThread();
 }
 
 void BOSSManager::reset()
 {
+    stopSearchThread();
+
     _previousSearchResults = BOSS::DFBB_BuildOrderSearchResults();
     _searchInProgress = false;
     _previousBuildOrder.clear();
@@ -47,6 +67,9 @@ void BOSSManager::startNewSearch(const std::vector<MetaPair> & goalUnits, shared
         return;
     }
 
+    // a search still running is for the old goals, drop it before its state is replaced
+    stopSearchThread();
+
     // convert from UAlbertaBot's meta goal type to BOSS ActionType goal
     try
     {
@@ -54,6 +77,23 @@ void BOSSManager::startNewSearch(const std::vector<MetaPair> & goalUnits, shared
 
         BOSS::GameState initialState(BWAPI::Broodwar, _opponentView->self(), buildingManager->buildingsQueued());
 
+        // a goal solved before from this state needs no search, the build order is ready next frame
+        BOSS::BuildOrder cachedBuildOrder;
+        if (_buildOrderCache.lookup(initialState, goal, cachedBuildOrder))
+        {
+            _searchInProgress = false;
+            _previousSearchStartFrame = currentFrame;
+            _previousSearchFinishFrame = currentFrame;
+            _totalPreviousSearchTime = 0;
+            _previousGoalUnits = goalUnits;
+            _previousBuildOrder = cachedBuildOrder;
+            _previousStatus = std::string("\x07") + "BOSS Cached Solution\n";
+            return;
+        }
+
+        _searchState = initialState;
+        _searchGoal = goal;
+
         _smartSearch = SearchPtr(new BOSS::DFBB_BuildOrderSmartSearch(initialState.getRace()));
         _smartSearch->setGoal(GetGoal(goalUnits));
         _smartSearch->setState(initialState);
@@ -62,6 +102,11 @@ void BOSSManager::startNewSearch(const std::vector<MetaPair> & goalUnits, shared
         _previousSearchStartFrame = currentFrame;
         _totalPreviousSearchTime = 0;
         _previousGoalUnits = goalUnits;
+
+        if (_useSearchThread)
+        {
+            startSearchThread();
+        }
     }
     catch (const BOSS::BOSSException)
     {
@@ -75,109 +120,186 @@ void BOSSManager::update(double timeLimit, int currentFrame)
     // if there's a search in progress, resume it
     if (isSearchInProgress())
     {
-        _previousStatus.clear();
-
-        // give the search at least 5ms to search this frame
-        double realTimeLimit = timeLimit < 0 ? 5 : timeLimit;
-        _smartSearch->setTimeLimit((int)realTimeLimit);
-		_hasExceptionDuringSearch = false;
+        bool searchTimeOut = currentFrame > (_previousSearchStartFrame + _bossFrameLimit);
 
-		try
+        if (_useSearchThread)
         {
-            // call the search to continue searching
-            // this will resume a search in progress or start a new search if not yet started
-			_smartSearch->search();
-		}
-        // catch any errors that might happen in the search
-		catch (const BOSS::BOSSException & exception)
+            // the search runs on its own thread, wait for it unless it has used up its frames
+            if (!_searchThreadDone && !searchTimeOut)
+            {
+                return;
+            }
+
+            _previousStatus.clear();
+            stopSearchThread();
+            _totalPreviousSearchTime = _searchThreadTime;
+            _hasExceptionDuringSearch = !_searchThreadException.empty();
+
+            if (_hasExceptionDuringSearch)
+            {
+                UAB_ASSERT_WARNING(false, "BOSS SmartSearch Exception: %s", _searchThreadException.c_str());
+                _previousStatus = "BOSSExeption";
+            }
+        }
+        else
         {
-            UAB_ASSERT_WARNING(false, "BOSS SmartSearch Exception: %s", exception.what());
-            _previousStatus = "BOSSExeption";
-			_hasExceptionDuringSearch = true;
-		}
+            _previousStatus.clear();
+
+            // give the search at least 5ms to search this frame
+            double realTimeLimit = timeLimit < 0 ? 5 : timeLimit;
+            _hasExceptionDuringSearch = false;
+
+            try
+            {
+                // give the search its slice of this frame in microseconds, the search stops where it is
+                // when the slice runs out and continues from there next frame
+                _smartSearch->step(realTimeLimit * 1000);
+            }
+            // catch any errors that might happen in the search
+            catch (const BOSS::BOSSException & exception)
+            {
+                UAB_ASSERT_WARNING(false, "BOSS SmartSearch Exception: %s", exception.what());
+                _previousStatus = "BOSSExeption";
+                _hasExceptionDuringSearch = true;
+            }
 
-		auto& searchResults = _smartSearch->getResults();
-        _totalPreviousSearchTime += searchResults.timeElapsed;
+            _totalPreviousSearchTime += _smartSearch->getResults().timeElapsed;
+        }
 
         // after the search finishes for this frame, check to see if we have a solution or if we hit the overall time limit
-        bool searchTimeOut = currentFrame > (_previousSearchStartFrame + _bossFrameLimit);
+        auto& searchResults = _smartSearch->getResults();
         bool previousSearchComplete = searchTimeOut || searchResults.solved || _hasExceptionDuringSearch;
         if (previousSearchComplete)
         {
-            bool solved = searchResults.solved && searchResults.solutionFound;
+            finishSearch(currentFrame, searchTimeOut);
+        }
+    }
+}
 
-            // if we've found a solution, let us know
-            if (searchResults.solved)
-            {
-                if (searchResults.solutionFound)
-                {
-                    _previousStatus = std::string("\x07") + "BOSS Solve Solution\n";
-                }
-                else
-                {
-                    _previousStatus = std::string("\x03") + "BOSS Solve NoSolution\n";
-                }
-            }
+// takes the result of a finished or timed out search, falling back to the naive search if it has no build order
+void BOSSManager::finishSearch(int currentFrame, bool searchTimeOut)
+{
+    auto& searchResults = _smartSearch->getResults();
+    bool solved = searchResults.solved && searchResults.solutionFound;
 
-            // re-set all the search information to get read for the next search
-            _searchInProgress = false;
-            _previousSearchFinishFrame = currentFrame;
-            _previousSearchResults = _smartSearch->getResults();
-            _savedSearchResults = _previousSearchResults;
-            _previousBuildOrder = _previousSearchResults.buildOrder;
+    // if we've found a solution, let us know
+    if (searchResults.solved)
+    {
+        if (searchResults.solutionFound)
+        {
+            _previousStatus = std::string("\x07") + "BOSS Solve Solution\n";
+        }
+        else
+        {
+            _previousStatus = std::string("\x03") + "BOSS Solve NoSolution\n";
+        }
+    }
+
+    // re-set all the search information to get read for the next search
+    _searchInProgress = false;
+    _previousSearchFinishFrame = currentFrame;
+    _previousSearchResults = _smartSearch->getResults();
+    _savedSearchResults = _previousSearchResults;
+    _previousBuildOrder = _previousSearchResults.buildOrder;
+
+    if (solved && _previousBuildOrder.size() == 0)
+    {
+        _previousStatus = std::string("\x07") + "BOSS Trivial Solve\n";
+    }
+
+    // only solved searches are kept, the best order a timed out search found may be far from optimal
+    if (solved && _previousBuildOrder.size() > 0 && _buildOrderCache.isOpen())
+    {
+        _buildOrderCache.store(_searchState, _searchGoal, _previousBuildOrder);
+    }
+
+    // if our search resulted in a build order of size 0 then something failed
+	_noSolutionFound = false;
+    if (!solved && _previousBuildOrder.size() == 0)
+    {
+        // log the debug information since this shouldn't happen if everything goes to plan
+        /*std::stringstream ss;
+        ss << _smartSearch->getParameters().toString() << "\n";
+        ss << "searchTimeOut: " << (searchTimeOut ? "true" : "false") << "\n";
+        ss << "caughtException: " << (caughtException ? "true" : "false") << "\n";
+        ss << "getResults().solved: " << (_smartSearch->getResults().solved ? "true" : "false") << "\n";
+        ss << "getResults().solutionFound: " << (_smartSearch->getResults().solutionFound ? "true" : "false") << "\n";
+        ss << "nodes: " << _savedSearchResults.nodesExpanded << "\n";
+        ss << "time: " << _savedSearchResults.timeElapsed << "\n";
+        Logger::LogOverwriteToFile("bwapi-data/AI/LastBadBuildOrder.txt", ss.str());*/
+        
+        // so try another naive build order search as a last resort
+        BOSS::NaiveBuildOrderSearch nbos(_smartSearch->getParameters().initialState, _smartSearch->getParameters().goal);
 
-            if (solved && _previousBuildOrder.size() == 0)
+		try
+        {
+            if (searchTimeOut)
             {
-                _previousStatus = std::string("\x07") + "BOSS Trivial Solve\n";
+                _previousStatus = std::string("\x02") + "BOSS Timeout\n";
             }
 
-            // if our search resulted in a build order of size 0 then something failed
-			_noSolutionFound = false;
-            if (!solved && _previousBuildOrder.size() == 0)
+            if (_hasExceptionDuringSearch)
             {
-                // log the debug information since this shouldn't happen if everything goes to plan
-                /*std::stringstream ss;
-                ss << _smartSearch->getParameters().toString() << "\n";
-                ss << "searchTimeOut: " << (searchTimeOut ? "true" : "false") << "\n";
-                ss << "caughtException: " << (caughtException ? "true" : "false") << "\n";
-                ss << "getResults().solved: " << (_smartSearch->getResults().solved ? "true" : "false") << "\n";
-                ss << "getResults().solutionFound: " << (_smartSearch->getResults().solutionFound ? "true" : "false") << "\n";
-                ss << "nodes: " << _savedSearchResults.nodesExpanded << "\n";
-                ss << "time: " << _savedSearchResults.timeElapsed << "\n";
-                Logger::LogOverwriteToFile("bwapi-data/AI/LastBadBuildOrder.txt", ss.str());*/
-                
-                // so try another naive build order search as a last resort
-                BOSS::NaiveBuildOrderSearch nbos(_smartSearch->getParameters().initialState, _smartSearch->getParameters().goal);
-
-				try
-                {
-                    if (searchTimeOut)
-                    {
-                        _previousStatus = std::string("\x02") + "BOSS Timeout\n";
-                    }
-
-                    if (_hasExceptionDuringSearch)
-                    {
-                        _previousStatus = std::string("\x02") + "BOSS Exception\n";
-                    }
-
-					_previousBuildOrder = nbos.solve();
-                    _previousStatus += "\x03NBOS Solution";
-
-					return;
-				}
-                // and if that search doesn't work then we're out of luck, no build orders forus
-				catch (const BOSS::BOSSException & exception)
-                {
-                    UAB_ASSERT_WARNING(false, "BOSS Timeout Naive Search Exception: %s", exception.what());
-                    _previousStatus += "\x08Naive Exception";
-					_noSolutionFound = true;
-					_previousBuildOrder = BOSS::BuildOrder();
-					return;
-				}
+                _previousStatus = std::string("\x02") + "BOSS Exception\n";
             }
+
+			_previousBuildOrder = nbos.solve();
+            _previousStatus += "\x03NBOS Solution";
+
+			return;
+		}
+        // and if that search doesn't work then we're out of luck, no build orders forus
+		catch (const BOSS::BOSSException & exception)
+        {
+            UAB_ASSERT_WARNING(false, "BOSS Timeout Naive Search Exception: %s", exception.what());
+            _previousStatus += "\x08Naive Exception";
+			_noSolutionFound = true;
+			_previousBuildOrder = BOSS::BuildOrder();
+			return;
+		}
+    }
+}
+
+// runs the search for the goal set in startNewSearch, the job owns _smartSearch until the thread is joined
+void BOSSManager::startSearchThread()
+{
+    _searchThreadDone = false;
+    _cancelSearchThread = false;
+    _searchThreadTime = 0;
+    _searchThreadException.clear();
+    _hasExceptionDuringSearch = false;
+
+    _searchThread = std::thread(&BOSSManager::runSearchThread, this);
+}
+
+// cancels the running search job, if any, and waits for the thread so the search can be read or replaced
+void BOSSManager::stopSearchThread()
+{
+    if (_searchThread.joinable())
+    {
+        _cancelSearchThread = true;
+        _searchThread.join();
+    }
+}
+
+// nothing in here may call into BWAPI or touch what the game thread reads, errors are kept in
+// _searchThreadException and reported by update() after the join
+void BOSSManager::runSearchThread()
+{
+    try
+    {
+        while (!_cancelSearchThread && !_smartSearch->getResults().solved)
+        {
+            _smartSearch->step(SearchThreadSliceMicros);
+            _searchThreadTime += _smartSearch->getResults().timeElapsed;
         }
     }
+    catch (const BOSS::BOSSException & exception)
+    {
+        _searchThreadException = exception.what();
+    }
+
+    _searchThreadDone = true;
 }
 
 void BOSSManager::logBadSearch()
@@ -3,6 +3,8 @@
 #include "Common.h"
 #include "../../BOSS/source/BOSS.h"
 #include <memory>
+#include <thread>
+#include <atomic>
 #include "OpponentView.h"
 #include "BuildingManager.h"
 #include "Strategy.h"
@@ -27,6 +29,20 @@ class BOSSManager
 	bool									_noSolutionFound;
 	int										_bossFrameLimit = 160;
 
+    // the search job runs on _searchThread, the game thread does not touch _smartSearch while it runs
+    // and only collects the result once _searchThreadDone is set or the frame limit is up
+    bool                                    _useSearchThread;
+    std::thread                             _searchThread;
+    std::atomic<bool>                       _searchThreadDone;
+    std::atomic<bool>                       _cancelSearchThread;
+    double                                  _searchThreadTime;
+    std::string                             _searchThreadException;
+
+    // solved searches are kept in _buildOrderCache under the state and goal they were started with
+    BOSS::BuildOrderCache                   _buildOrderCache;
+    BOSS::GameState                         _searchState;
+    BOSS::BuildOrderSearchGoal              _searchGoal;
+
     SearchPtr                               _smartSearch;
 
     BOSS::DFBB_BuildOrderSearchResults      _previousSearchResults;
@@ -47,13 +63,20 @@ class BOSSManager
 
     void                                    logBadSearch();
 
+    void                                    startSearchThread();
+    void                                    stopSearchThread();
+    void                                    runSearchThread();
+    void                                    finishSearch(int currentFrame, bool searchTimeOut);
+
 
 public:
 	
 	BOSSManager(
 		shared_ptr<AKBot::OpponentView> opponentView,
+		const BotMacroConfiguration& macroConfiguration,
 		const BotDebugConfiguration& debugConfiguration);
 	BOSSManager(const BOSSManager&) = delete;
+	~BOSSManager();
 
 	void						update(double timeLimit, int currentFrame);
     void                        reset();
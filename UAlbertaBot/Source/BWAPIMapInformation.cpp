@@ -30,3 +30,8 @@ bool AKBot::BWAPIMapInformation::isExplored(int tileX, int tileY) const
 {
 	return BWAPI::Broodwar->isExplored(tileX, tileY);
 }
+
+std::string AKBot::BWAPIMapInformation::getMapHash() const
+{
+	return BWAPI::Broodwar->mapHash();
+}
@@ -12,5 +12,6 @@ namespace AKBot
 		bool isVisible(int x, int y) const override;
 		bool isBuildable(int x, int y) const override;
 		bool isExplored(int tileX, int tileY) const override;
+		std::string getMapHash() const override;
 	};
 }
\ No newline at end of file
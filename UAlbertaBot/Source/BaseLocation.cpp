@@ -64,7 +64,7 @@ BaseLocation::BaseLocation(std::shared_ptr<AKBot::OpponentView> opponentView, sh
 
     // compute this BaseLocation's DistanceMap, which will compute the ground distance
     // from the center of its recourses to every other tile on the map
-    _distanceMap = _mapTools->getDistanceMap(_centerOfResources);
+    _distanceMap = *_mapTools->getDistanceMap(_centerOfResources);
 
     // check to see if this is a start location for the map
     for (auto & tilePos : BWAPI::Broodwar->getStartLocations())
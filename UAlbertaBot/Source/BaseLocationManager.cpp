@@ -22,9 +22,10 @@ void BaseLocationManager::onStart(shared_ptr<MapTools> map)
     // so we will first look over all minerals and cluster them based on some distance
     const int clusterDistance = 20;
 
+	// every cluster has a different center, an exact distance would run a BFS over the map for each of them
 	auto distanceFunction = [&map](const BWAPI::Position & src, const BWAPI::Position & dest)
 	{
-		return map->getGroundDistance(src, dest);
+		return map->getApproxGroundDistance(src, dest);
 	};
 	// stores each cluster of resources based on some ground distance
     std::vector<std::vector<BWAPI::Unit>> resourceClusters;
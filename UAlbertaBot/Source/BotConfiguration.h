@@ -123,6 +123,9 @@ struct BotMicroConfiguration
 struct BotMacroConfiguration
 {
 	int BOSSFrameLimit = 160;
+	bool BOSSSearchThread = true;      // run the build order search on a worker thread instead of the game thread
+	std::string BOSSCacheReadFile;     // file of build orders kept from earlier games, empty to not read one
+	std::string BOSSCacheWriteFile;    // where the build orders are kept for later games, empty to not write them
 	int WorkersPerRefinery = 3;
 	int BuildingSpacing = 1;
 	int PylonSpacing = 3;
@@ -131,6 +134,12 @@ struct BotMacroConfiguration
 struct BotToolsConfiguration
 {
 	int MAP_GRID_SIZE = 320;      // size of grid spacing in MapGrid
+	int DistanceMapCacheMB = 32;  // memory the cached distance maps in MapTools may use before the least recently used are dropped
+	std::string MapAnalysisReadDir = "bwapi-data/read/";   // where map analysis files are looked for, empty to always analyse the map
+	std::string MapAnalysisWriteDir = "bwapi-data/write/"; // where a map analysis file is written after analysing a map, empty to not write one
+	int LastSeenUpdateFrames = 1; // MapTools updates the last time each tile was seen once every this many frames
+	int PathSearchesPerFrame = 20; // ground paths MapTools may search for each frame, paths already cached don't count
+	int PathCacheSize = 256;      // routes between region graph portals the path finder keeps
 };
 
 struct BotConfiguration
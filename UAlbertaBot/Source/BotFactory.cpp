@@ -35,7 +35,7 @@ BotPlayer AKBot::createBot(const std::string& mode, BotConfiguration& configurat
 			logger,
 			configuration.Strategy));
 		auto mapInformation = std::shared_ptr<MapInformation>(new BWAPIMapInformation());
-		auto mapTools = std::shared_ptr<MapTools>(new MapTools(mapInformation, logger));
+		auto mapTools = std::shared_ptr<MapTools>(new MapTools(opponentView, mapInformation, logger, configuration.Tools));
 		auto combatCommander = std::shared_ptr<CombatCommander>(new CombatCommander(
 			baseLocationManager,
 			opponentView,
@@ -46,7 +46,7 @@ BotPlayer AKBot::createBot(const std::string& mode, BotConfiguration& configurat
 			configuration.Micro,
 			configuration.SparCraft,
 			configuration.Debug));
-		auto bossManager = std::shared_ptr<BOSSManager>(new BOSSManager(opponentView, configuration.Debug));
+		auto bossManager = std::shared_ptr<BOSSManager>(new BOSSManager(opponentView, configuration.Macro, configuration.Debug));
 		auto scoutManager = std::shared_ptr<ScoutManager>(new ScoutManager(
 			opponentView,
 			baseLocationManager,
@@ -216,7 +216,7 @@ BWAPI::TilePosition BuildingPlacer::getBuildLocationNear(const Building & b,int
     t.start();
 
     // get the precomputed vector of tile positions which are sorted closes to this location
-    const std::vector<BWAPI::TilePosition> & closestToBuilding = _mapTools->getClosestTilesTo(BWAPI::Position(b.desiredPosition));
+    const std::shared_ptr<const std::vector<BWAPI::TilePosition>> closestToBuilding = _mapTools->getClosestTilesTo(BWAPI::Position(b.desiredPosition));
 
     // special easy case of having no pylons
     int numPylons = _opponentView->self()->completedUnitCount(BWAPI::UnitTypes::Protoss_Pylon);
@@ -226,12 +226,12 @@ BWAPI::TilePosition BuildingPlacer::getBuildLocationNear(const Building & b,int
     }
 
     // iterate through the list until we've found a suitable location
-    for (size_t i(0); i < closestToBuilding.size(); ++i)
+    for (size_t i(0); i < closestToBuilding->size(); ++i)
     {
-		auto checkStatus = canBuildHereWithSpace(closestToBuilding[i], b, buildDist, horizontalOnly);
+		auto checkStatus = canBuildHereWithSpace((*closestToBuilding)[i], b, buildDist, horizontalOnly);
         if (checkStatus == BuildingPlaceCheckStatus::CanBuild)
         {
-            return closestToBuilding[i];
+            return (*closestToBuilding)[i];
         }
     }
 
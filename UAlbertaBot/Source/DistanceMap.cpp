@@ -2,6 +2,7 @@
 #include "UABAssert.h"
 #include "Timer.hpp"
 #include <functional>
+#include <algorithm>
 
 using namespace UAlbertaBot;
 
@@ -9,58 +10,87 @@ const size_t LegalActions = 4;
 const int actionX[LegalActions] = {1, -1, 0, 0};
 const int actionY[LegalActions] = {0, 0, 1, -1};
 
+// the distance stored for tiles that can't be reached from the start tile
+const unsigned short Unreachable = 0xFFFF;
+
 DistanceMap::DistanceMap()
+    : _width    (0)
+    , _height   (0)
 {
 
 }
 
 DistanceMap::DistanceMap(const BWAPI::TilePosition & startTile, int width, int height, TileCheckFunc isWalkable)
-    : _width    (width)
-    , _height   (height)
-    , _startTile(startTile)
-	, _isWalkable(isWalkable)
-    , _dist     (width, std::vector<int>(height, -1))
 {
-	computeDistanceMap(_startTile, isWalkable);
-    _sortedTilePositions.reserve(_width * _height);
+    reset(startTile, width, height, isWalkable);
+}
+
+void DistanceMap::reset(const BWAPI::TilePosition & startTile, int width, int height, TileCheckFunc isWalkable)
+{
+    _width = width;
+    _height = height;
+    _startTile = startTile;
+
+    // the sorted tiles are given back rather than kept, the next start tile may never need them
+    _dist.assign(width * height, Unreachable);
+    std::vector<BWAPI::TilePosition>().swap(_sortedTilePositions);
+
+    computeDistanceMap(_startTile, isWalkable);
 }
 
-const int & DistanceMap::getDistance(const int & tileX, const int & tileY) const
+int DistanceMap::getDistance(const int & tileX, const int & tileY) const
 { 
     UAB_ASSERT(tileX < _width && tileY < _height, "Index out of range: X = %d, Y = %d", tileX, tileY);
-    return _dist[tileX][tileY]; 
+    const unsigned short dist = _dist[tileY * _width + tileX];
+    return (dist == Unreachable) ? -1 : dist;
 }
 
-const int & DistanceMap::getDistance(const BWAPI::Position & pos) const
+int DistanceMap::getDistance(const BWAPI::Position & pos) const
 { 
     return getDistance(BWAPI::TilePosition(pos)); 
 }
 
-const int & DistanceMap::getDistance(const BWAPI::TilePosition & pos) const
+int DistanceMap::getDistance(const BWAPI::TilePosition & pos) const
 { 
     return getDistance(pos.x, pos.y); 
 }
 
+const BWAPI::TilePosition & DistanceMap::getStartTile() const
+{
+    return _startTile;
+}
+
+// bytes held by this map, counting what is allocated rather than what is used since reset keeps it
+size_t DistanceMap::getMemoryUsage() const
+{
+    return sizeof(DistanceMap) 
+        + _dist.capacity() * sizeof(unsigned short) 
+        + _sortedTilePositions.capacity() * sizeof(BWAPI::TilePosition);
+}
+
 const std::vector<BWAPI::TilePosition> & DistanceMap::getSortedTiles() const
 {
+    if (_sortedTilePositions.empty() && _width > 0)
+    {
+        computeSortedTiles();
+    }
+
     return _sortedTilePositions;
 }
 
-// Computes _dist[x][y] = ground distance from (startX, startY) to (x,y)
+// Computes the ground distance from startTile to every tile
 // Uses BFS, since the map is quite large and DFS may cause a stack overflow
 void DistanceMap::computeDistanceMap(const BWAPI::TilePosition & startTile, TileCheckFunc isWalkable)
 {
-    // the fringe for the BFS we will perform to calculate distances
     std::vector<BWAPI::TilePosition> fringe;
-    fringe.reserve(_width * _height);
     fringe.push_back(startTile);
-    _sortedTilePositions.push_back(startTile);
 
-    _dist[startTile.x][startTile.y] = 0;
+    _dist[startTile.y * _width + startTile.x] = 0;
 
     for (size_t fringeIndex=0; fringeIndex<fringe.size(); ++fringeIndex)
     {
-        const BWAPI::TilePosition & tile = fringe[fringeIndex];
+        const BWAPI::TilePosition tile = fringe[fringeIndex];
+        const unsigned short tileDist = _dist[tile.y * _width + tile.x];
 
         // check every possible child of this tile
         for (size_t a=0; a<LegalActions; ++a)
@@ -68,10 +98,39 @@ void DistanceMap::computeDistanceMap(const BWAPI::TilePosition & startTile, Tile
             BWAPI::TilePosition nextTile(tile.x + actionX[a], tile.y + actionY[a]);
 
             // if the new tile is inside the map bounds, is walkable, and has not been visited yet, set the distance of its parent + 1
-            if (nextTile.isValid() && isWalkable(nextTile) && getDistance(nextTile) == -1)
+            if (nextTile.x >= 0 && nextTile.y >= 0 && nextTile.x < _width && nextTile.y < _height &&
+                _dist[nextTile.y * _width + nextTile.x] == Unreachable && isWalkable(nextTile))
             {
-                _dist[nextTile.x][nextTile.y] = _dist[tile.x][tile.y] + 1;
+                // a walk as long as the tile count would clash with Unreachable, no real map comes close
+                _dist[nextTile.y * _width + nextTile.x] = std::min(tileDist + 1, Unreachable - 1);
                 fringe.push_back(nextTile);
+            }
+        }
+    }
+}
+
+// Replays the BFS over the stored distances, a tile is reached from the first tile one step closer that
+// is next to it, just as computeDistanceMap first reached it, so the tiles come out in the same order
+void DistanceMap::computeSortedTiles() const
+{
+    std::vector<bool> added(_dist.size(), false);
+
+    _sortedTilePositions.push_back(_startTile);
+    added[_startTile.y * _width + _startTile.x] = true;
+
+    for (size_t fringeIndex=0; fringeIndex<_sortedTilePositions.size(); ++fringeIndex)
+    {
+        const BWAPI::TilePosition tile = _sortedTilePositions[fringeIndex];
+        const unsigned short tileDist = _dist[tile.y * _width + tile.x];
+
+        for (size_t a=0; a<LegalActions; ++a)
+        {
+            BWAPI::TilePosition nextTile(tile.x + actionX[a], tile.y + actionY[a]);
+
+            if (nextTile.x >= 0 && nextTile.y >= 0 && nextTile.x < _width && nextTile.y < _height &&
+                !added[nextTile.y * _width + nextTile.x] && _dist[nextTile.y * _width + nextTile.x] == tileDist + 1)
+            {
+                added[nextTile.y * _width + nextTile.x] = true;
                 _sortedTilePositions.push_back(nextTile);
             }
         }
@@ -14,23 +14,34 @@ class DistanceMap
     int _width;
     int _height;
     BWAPI::TilePosition _startTile;
-	TileCheckFunc _isWalkable;
 
-    std::vector<std::vector<int>> _dist;
-    std::vector<BWAPI::TilePosition> _sortedTilePositions;
+    // distances are stored row by row in 16 bits, 0xFFFF for a tile that can't be reached from the start tile
+    std::vector<unsigned short> _dist;
+
+    // the reachable tiles in BFS order, four times the size of the distances, so only made for the maps asked for it
+    mutable std::vector<BWAPI::TilePosition> _sortedTilePositions;
 
     void computeDistanceMap(const BWAPI::TilePosition & startTile, TileCheckFunc isWalkable);
+    void computeSortedTiles() const;
 
 public:
 
     DistanceMap();
     DistanceMap(const BWAPI::TilePosition & startTile, int width, int height, TileCheckFunc isWalkable);
 
-    const int & getDistance(const int & tileX, const int & tileY) const;
-    const int & getDistance(const BWAPI::Position & pos) const;
-    const int & getDistance(const BWAPI::TilePosition & pos) const;
+    // recomputes the map for another start tile, keeping the memory already allocated
+    void reset(const BWAPI::TilePosition & startTile, int width, int height, TileCheckFunc isWalkable);
+
+    // the ground distance in tiles, or -1 if the tile can't be reached
+    int getDistance(const int & tileX, const int & tileY) const;
+    int getDistance(const BWAPI::Position & pos) const;
+    int getDistance(const BWAPI::TilePosition & pos) const;
+
+    const BWAPI::TilePosition & getStartTile() const;
+    size_t getMemoryUsage() const;
 
     // given a position, get the position we should move to to minimize distance
+    // the list is made from the distances by the first call
     const std::vector<BWAPI::TilePosition> & getSortedTiles() const;
 };
 }
\ No newline at end of file
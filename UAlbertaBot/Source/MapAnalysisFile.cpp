@@ -0,0 +1,169 @@
+#include "MapAnalysisFile.h"
+#include <fstream>
+
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace UAlbertaBot;
+
+namespace
+{
+    const unsigned int Magic = 0x4150414D;     // "MAPA"
+    const unsigned int Version = 2;
+
+    struct Header
+    {
+        unsigned int magic;
+        unsigned int version;
+        unsigned int dataSize;
+    };
+}
+
+bool MapAnalysisWriter::save(const std::string & filename) const
+{
+    std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    // the magic goes in last so a file the game stopped half way through writing is never read
+    Header header;
+    header.magic = 0;
+    header.version = Version;
+    header.dataSize = (unsigned int)_data.size();
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(_data.data(), _data.size());
+
+    header.magic = Magic;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+
+    return file.good();
+}
+
+MapAnalysisReader::MapAnalysisReader()
+    : _data     (NULL)
+    , _size     (0)
+    , _position (0)
+#ifdef WIN32
+    , _file     (INVALID_HANDLE_VALUE)
+    , _mapping  (NULL)
+#else
+    , _file     (-1)
+#endif
+{
+
+}
+
+MapAnalysisReader::~MapAnalysisReader()
+{
+    close();
+}
+
+bool MapAnalysisReader::open(const std::string & filename)
+{
+    close();
+
+#ifdef WIN32
+    _file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    LARGE_INTEGER size;
+    if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size) || size.QuadPart < (LONGLONG)sizeof(Header))
+    {
+        close();
+        return false;
+    }
+
+    _size = (size_t)size.QuadPart;
+    _mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    _data = (_mapping == NULL) ? NULL : (const char *)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    _file = ::open(filename.c_str(), O_RDONLY);
+
+    struct stat fileStat;
+    if (_file < 0 || fstat(_file, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(Header))
+    {
+        close();
+        return false;
+    }
+
+    _size = (size_t)fileStat.st_size;
+    void * data = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, _file, 0);
+    _data = (data == MAP_FAILED) ? NULL : (const char *)data;
+#endif
+
+    if (_data == NULL)
+    {
+        close();
+        return false;
+    }
+
+    Header header;
+    read(header);
+
+    if (header.magic != Magic || header.version != Version || header.dataSize != _size - sizeof(Header))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void MapAnalysisReader::close()
+{
+#ifdef WIN32
+    if (_data != NULL)
+    {
+        UnmapViewOfFile(_data);
+    }
+
+    if (_mapping != NULL)
+    {
+        CloseHandle(_mapping);
+    }
+
+    if (_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_file);
+    }
+
+    _mapping = NULL;
+    _file = INVALID_HANDLE_VALUE;
+#else
+    if (_data != NULL)
+    {
+        munmap((void *)_data, _size);
+    }
+
+    if (_file >= 0)
+    {
+        ::close(_file);
+    }
+
+    _file = -1;
+#endif
+
+    _data = NULL;
+    _size = 0;
+    _position = 0;
+}
+
+bool MapAnalysisReader::isOpen() const
+{
+    return _data != NULL;
+}
+
+bool MapAnalysisReader::canRead(size_t bytes) const
+{
+    return _data != NULL && bytes <= _size - _position;
+}
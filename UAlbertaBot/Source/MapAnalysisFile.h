@@ -0,0 +1,105 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace UAlbertaBot
+{
+
+// builds the contents of a map analysis file in memory and writes it out in one go
+// values are written as their raw bytes, vectors as their size followed by their elements
+class MapAnalysisWriter
+{
+    std::vector<char> _data;
+
+public:
+
+    template <class T>
+    void write(const T & value)
+    {
+        const char * bytes = reinterpret_cast<const char *>(&value);
+        _data.insert(_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <class T>
+    void write(const std::vector<T> & values)
+    {
+        write((unsigned int)values.size());
+
+        if (!values.empty())
+        {
+            const char * bytes = reinterpret_cast<const char *>(values.data());
+            _data.insert(_data.end(), bytes, bytes + values.size() * sizeof(T));
+        }
+    }
+
+    // writes the header and the data to the file, false if the file couldn't be written
+    bool save(const std::string & filename) const;
+};
+
+// a read only memory mapping of a file written by MapAnalysisWriter, read front to back
+// every read checks it stays inside the file, so a truncated or foreign file fails to read instead of crashing
+class MapAnalysisReader
+{
+    const char *    _data;
+    size_t          _size;
+    size_t          _position;
+
+#ifdef WIN32
+    void *          _file;
+    void *          _mapping;
+#else
+    int             _file;
+#endif
+
+    MapAnalysisReader(const MapAnalysisReader & other);
+    MapAnalysisReader & operator = (const MapAnalysisReader & other);
+
+    bool canRead(size_t bytes) const;
+
+public:
+
+    MapAnalysisReader();
+    ~MapAnalysisReader();
+
+    // maps the file and checks its header, false if it doesn't exist or was written by another version
+    bool open(const std::string & filename);
+    void close();
+    bool isOpen() const;
+
+    template <class T>
+    bool read(T & value)
+    {
+        if (!canRead(sizeof(T)))
+        {
+            return false;
+        }
+
+        memcpy(&value, _data + _position, sizeof(T));
+        _position += sizeof(T);
+        return true;
+    }
+
+    template <class T>
+    bool read(std::vector<T> & values)
+    {
+        unsigned int size = 0;
+
+        if (!read(size) || !canRead((size_t)size * sizeof(T)))
+        {
+            return false;
+        }
+
+        values.resize(size);
+        if (size > 0)
+        {
+            memcpy(values.data(), _data + _position, size * sizeof(T));
+        }
+
+        _position += size * sizeof(T);
+        return true;
+    }
+};
+
+}
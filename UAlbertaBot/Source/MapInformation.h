@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 namespace AKBot
 {
 	class MapInformation
@@ -12,5 +14,6 @@ namespace AKBot
 		virtual bool isVisible(int x, int y) const = 0;
 		virtual bool isBuildable(int x, int y) const = 0;
 		virtual bool isExplored(int tileX, int tileY) const = 0;
+		virtual std::string getMapHash() const = 0;
 	};
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <type_traits>
 #include <BWAPI.h>
 #include <fstream>
+#include <algorithm>
+#include <iterator>
 
 using namespace UAlbertaBot;
 
@@ -12,41 +14,178 @@ const size_t LegalActions = 4;
 const int actionX[LegalActions] = {1, -1, 0, 0};
 const int actionY[LegalActions] = {0, 0, 1, -1};
 
+// the cache always keeps this many distance maps, however small the memory limit is
+const size_t MinCachedDistanceMaps = 2;
+
+// a unit this close to a waypoint goes on to the next one
+const int WaypointReachedDistance = 64;
+
 // constructor for MapTools
-MapTools::MapTools(shared_ptr<AKBot::MapInformation> mapInformation, std::shared_ptr<AKBot::Logger> logger)
+MapTools::MapTools(shared_ptr<AKBot::OpponentView> opponentView, shared_ptr<AKBot::MapInformation> mapInformation, std::shared_ptr<AKBot::Logger> logger, const BotToolsConfiguration& toolsConfiguration)
     : _width            (mapInformation->getWidth())
     , _height           (mapInformation->getHeight())
+    , _distanceMapHits  (0)
+    , _distanceMapMisses(0)
+    , _distanceMapMemoryLimit((size_t)std::max(toolsConfiguration.DistanceMapCacheMB, 0) * 1024 * 1024)
+	, _pathFinder(_regionGraph, toolsConfiguration.PathSearchesPerFrame, (size_t)std::max(toolsConfiguration.PathCacheSize, 1))
+	, _logger(logger)
+	, _mapAnalysisReadDir(toolsConfiguration.MapAnalysisReadDir)
+	, _mapAnalysisWriteDir(toolsConfiguration.MapAnalysisWriteDir)
+	, _lastSeenUpdateInterval(std::max(toolsConfiguration.LastSeenUpdateFrames, 1))
+	, _lastUpdateTime(0)
 	, _mapInformation(mapInformation)
+	, _opponentView(opponentView)
     , _walkable         (mapInformation->getWidth(), std::vector<bool>(mapInformation->getHeight(), false))
     , _buildable        (mapInformation->getWidth(), std::vector<bool>(mapInformation->getHeight(), true))
     , _depotBuildable   (mapInformation->getWidth(), std::vector<bool>(mapInformation->getHeight(), true))
-    , _lastSeen         (mapInformation->getWidth(), std::vector<int> (mapInformation->getHeight(), 0))
+    , _lastSeen         (mapInformation->getWidth() * mapInformation->getHeight(), 0)
     , _sectorNumber     (mapInformation->getWidth(), std::vector<int> (mapInformation->getHeight(), 0))
-	, _logger(logger)
 {
-    setBWAPIMapData();
 
-    computeConnectivity();
 }
 
 void MapTools::onStart()
 {
-    
+    // nothing computed here changes from game to game on the same map, so it is kept in a file named by the map hash
+    const std::string mapAnalysisFile = _mapInformation->getMapHash() + ".map";
+
+    if (!_mapAnalysisReadDir.empty() && readMapAnalysis(_mapAnalysisReadDir + mapAnalysisFile))
+    {
+        return;
+    }
+
+    setBWAPIMapData();
+    computeConnectivity();
+    _regionGraph.compute((int)_width, (int)_height, _walkable);
+
+    if (!_mapAnalysisWriteDir.empty())
+    {
+        writeMapAnalysis(_mapAnalysisWriteDir + mapAnalysisFile);
+    }
+}
+
+// the tile grids are written column by column, the same way they are indexed
+void MapTools::writeMapAnalysis(const std::string & filename) const
+{
+    std::vector<unsigned char> walkable, buildable, depotBuildable;
+    std::vector<int> sectorNumber;
+
+    for (size_t x = 0; x < _width; ++x)
+    {
+        for (size_t y = 0; y < _height; ++y)
+        {
+            walkable.push_back(_walkable[x][y]);
+            buildable.push_back(_buildable[x][y]);
+            depotBuildable.push_back(_depotBuildable[x][y]);
+            sectorNumber.push_back(_sectorNumber[x][y]);
+        }
+    }
+
+    MapAnalysisWriter writer;
+    writer.write((int)_width);
+    writer.write((int)_height);
+    writer.write(walkable);
+    writer.write(buildable);
+    writer.write(depotBuildable);
+    writer.write(sectorNumber);
+    _regionGraph.write(writer);
+
+    if (!writer.save(filename))
+    {
+        _logger->log("Could not write map analysis file %s", filename.c_str());
+    }
+}
+
+bool MapTools::readMapAnalysis(const std::string & filename)
+{
+    MapAnalysisReader reader;
+    if (!reader.open(filename))
+    {
+        return false;
+    }
+
+    int width = 0, height = 0;
+    std::vector<unsigned char> walkable, buildable, depotBuildable;
+    std::vector<int> sectorNumber;
+    const size_t tiles = _width * _height;
+
+    if (!reader.read(width) || !reader.read(height) || width != (int)_width || height != (int)_height ||
+        !reader.read(walkable) || !reader.read(buildable) || !reader.read(depotBuildable) || !reader.read(sectorNumber) ||
+        walkable.size() != tiles || buildable.size() != tiles || depotBuildable.size() != tiles || sectorNumber.size() != tiles ||
+        !_regionGraph.read(reader))
+    {
+        return false;
+    }
+
+    for (size_t x = 0; x < _width; ++x)
+    {
+        for (size_t y = 0; y < _height; ++y)
+        {
+            const size_t i = x * _height + y;
+
+            _walkable[x][y] = walkable[i] != 0;
+            _buildable[x][y] = buildable[i] != 0;
+            _depotBuildable[x][y] = depotBuildable[i] != 0;
+            _sectorNumber[x][y] = sectorNumber[i];
+        }
+    }
+
+    return true;
 }
 
 void MapTools::update(int currentFrame)
 {
-    // update all the tiles that we see this frame
-	for (size_t x = 0; x < _width; ++x)
+	_pathFinder.onFrame();
+
+	if (currentFrame % _lastSeenUpdateInterval != 0)
 	{
-		for (size_t y = 0; y < _height; ++y)
+		return;
+	}
+
+	Timer timer;
+	timer.start();
+
+	// a tile can only be visible if it is in sight of one of our units, so only the tiles around them are checked
+	auto self = _opponentView->self();
+	for (auto & unit : self->getUnits())
+	{
+		const BWAPI::Position position = unit->getPosition();
+		if (!position.isValid())
+		{
+			continue;
+		}
+
+		// half a tile more than the sight range takes in every tile the sight circle touches
+		const int range = self->sightRange(unit->getType()) + 16;
+		const int minX = std::max((position.x - range) / 32, 0);
+		const int maxX = std::min((position.x + range) / 32, (int)_width - 1);
+		const int minY = std::max((position.y - range) / 32, 0);
+		const int maxY = std::min((position.y + range) / 32, (int)_height - 1);
+
+		for (int y = minY; y <= maxY; ++y)
 		{
-			if (_mapInformation->isVisible(x, y))
+			for (int x = minX; x <= maxX; ++x)
 			{
-				_lastSeen[x][y] = currentFrame;
+				const int dx = x * 32 + 16 - position.x;
+				const int dy = y * 32 + 16 - position.y;
+				int & lastSeen = _lastSeen[y * _width + x];
+
+				// tiles in sight of more than one unit are only checked once
+				if (dx * dx + dy * dy > range * range || lastSeen == currentFrame)
+				{
+					continue;
+				}
+
+				if (_mapInformation->isVisible(x, y))
+				{
+					lastSeen = currentFrame;
+				}
 			}
 		}
 	}
+
+	timer.stop();
+	_lastUpdateTime = timer.getElapsedTimeInMilliSec();
 }
 
 void MapTools::computeConnectivity()
@@ -216,46 +355,122 @@ bool MapTools::isDepotBuildableTile(BWAPI::TilePosition tile) const
 
 int MapTools::getGroundDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const
 {
-    if (_allMaps.size() > 50)
+    return getDistanceMap(dest)->getDistance(src);
+}
+
+
+int MapTools::getGroundDistance(const BWAPI::Position & src, const BWAPI::Position & dest) const
+{
+    return getGroundDistance(BWAPI::TilePosition(src), BWAPI::TilePosition(dest));
+}
+
+// the answer only depends on the two tiles, never on which distance maps happen to be cached
+int MapTools::getApproxGroundDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const
+{
+    // the region graph only knows walkable tiles, units can stand on tiles the walkable grid doesn't count
+    if (_regionGraph.isComputed() && src.isValid() && dest.isValid() && _walkable[src.x][src.y] && _walkable[dest.x][dest.y])
     {
-        _allMaps.clear();
+        return _regionGraph.getDistance(src, dest);
     }
 
-    return getDistanceMap(dest).getDistance(src);
+    return getGroundDistance(src, dest);
 }
 
+int MapTools::getApproxGroundDistance(const BWAPI::Position & src, const BWAPI::Position & dest) const
+{
+    return getApproxGroundDistance(BWAPI::TilePosition(src), BWAPI::TilePosition(dest));
+}
 
-int MapTools::getGroundDistance(const BWAPI::Position & src, const BWAPI::Position & dest) const
+bool MapTools::getPath(const BWAPI::Position & src, const BWAPI::Position & dest, std::vector<BWAPI::Position> & path) const
 {
-    return getGroundDistance(BWAPI::TilePosition(src), BWAPI::TilePosition(dest));
+    return _pathFinder.getPath(src, dest, path);
 }
 
-const DistanceMap & MapTools::getDistanceMap(const BWAPI::TilePosition & tile) const
+// where a ground unit at src should move to on its way to dest, dest itself if no path could be found this frame
+BWAPI::Position MapTools::getNextWaypoint(const BWAPI::Position & src, const BWAPI::Position & dest) const
 {
+    return _pathFinder.getNextWaypoint(src, dest, WaypointReachedDistance);
+}
+
+std::shared_ptr<const DistanceMap> MapTools::getDistanceMap(const BWAPI::TilePosition & tile) const
+{
+	UAB_ASSERT(tile.isValid(), "Getting distance map of invalid tile");
+
+	auto found = _distanceMapIndex.find(tile);
+	if (found != _distanceMapIndex.end())
+	{
+		++_distanceMapHits;
+
+		// move the map to the front of the list, splicing keeps the iterators in the index valid
+		_distanceMaps.splice(_distanceMaps.begin(), _distanceMaps, found->second);
+		return _distanceMaps.front();
+	}
+
+	++_distanceMapMisses;
+
+	// a miss isn't spread over frames, the whole BFS is paid for here
+	// the bounds were checked when the BFS got to the tile, so it can read the walkable grid directly
 	auto isWalkable = [this](const BWAPI::TilePosition& tile)
 	{ 
-		return this->isWalkable(tile);
+		return this->_walkable[tile.x][tile.y];
 	};
-	if (_allMaps.find(tile) == _allMaps.end())
-    {
-        _allMaps[tile] = DistanceMap(tile, _width, _height, isWalkable);
-    }
 
-    return _allMaps[tile];
+	// a map grows when its sorted tiles are first asked for, so the memory is counted from the maps on every miss
+	size_t memory = getDistanceMapCacheMemory();
+
+	// when another map would go over the memory limit the least recently used one is reused, which also saves allocating it,
+	// a map the cache is no longer the only holder of is left to its holders instead
+	std::shared_ptr<DistanceMap> distanceMap;
+	if (_distanceMaps.size() >= MinCachedDistanceMaps && 
+		memory + _distanceMaps.back()->getMemoryUsage() > _distanceMapMemoryLimit)
+	{
+		_distanceMapIndex.erase(_distanceMaps.back()->getStartTile());
+		memory -= _distanceMaps.back()->getMemoryUsage();
+
+		if (_distanceMaps.back().use_count() == 1)
+		{
+			distanceMap = _distanceMaps.back();
+		}
+
+		_distanceMaps.pop_back();
+	}
+
+	if (!distanceMap)
+	{
+		distanceMap = std::make_shared<DistanceMap>();
+	}
+
+	distanceMap->reset(tile, _width, _height, isWalkable);
+	memory += distanceMap->getMemoryUsage();
+	_distanceMaps.push_front(distanceMap);
+	_distanceMapIndex[tile] = _distanceMaps.begin();
+
+	// a reused map can have grown past what it held before, drop maps from the back until the cache fits again
+	while (memory > _distanceMapMemoryLimit && _distanceMaps.size() > MinCachedDistanceMaps)
+	{
+		_distanceMapIndex.erase(_distanceMaps.back()->getStartTile());
+		memory -= _distanceMaps.back()->getMemoryUsage();
+		_distanceMaps.pop_back();
+	}
+
+	return distanceMap;
 }
 
-const DistanceMap & MapTools::getDistanceMap(const BWAPI::Position & pos) const
+std::shared_ptr<const DistanceMap> MapTools::getDistanceMap(const BWAPI::Position & pos) const
 {
     return getDistanceMap(BWAPI::TilePosition(pos));
 }
 
-const std::vector<BWAPI::TilePosition> & MapTools::getClosestTilesTo(const BWAPI::TilePosition & tile) const
+std::shared_ptr<const std::vector<BWAPI::TilePosition>> MapTools::getClosestTilesTo(const BWAPI::TilePosition & tile) const
 {
-    return getDistanceMap(tile).getSortedTiles();
+    std::shared_ptr<const DistanceMap> distanceMap = getDistanceMap(tile);
+
+    // shares ownership of the map the list belongs to
+    return std::shared_ptr<const std::vector<BWAPI::TilePosition>>(distanceMap, &distanceMap->getSortedTiles());
 }
 
 // returns a list of all tiles on the map, sorted by 4-direcitonal walk distance from the given position
-const std::vector<BWAPI::TilePosition> & MapTools::getClosestTilesTo(BWAPI::Position pos) const
+std::shared_ptr<const std::vector<BWAPI::TilePosition>> MapTools::getClosestTilesTo(BWAPI::Position pos) const
 {
     return getClosestTilesTo(BWAPI::TilePosition(pos));
 }
@@ -308,5 +523,46 @@ bool MapTools::isConnected(const BWAPI::Position & from, const BWAPI::Position &
 
 int MapTools::getLastSeen(int x, int y) const
 {
-	return _lastSeen[x][y];
+	return _lastSeen[y * _width + x];
+}
+
+double MapTools::getLastUpdateTime() const
+{
+	return _lastUpdateTime;
+}
+
+const RegionGraph & MapTools::getRegionGraph() const
+{
+	return _regionGraph;
+}
+
+const PathFinder & MapTools::getPathFinder() const
+{
+	return _pathFinder;
+}
+
+size_t MapTools::getNumCachedDistanceMaps() const
+{
+	return _distanceMaps.size();
+}
+
+size_t MapTools::getDistanceMapCacheMemory() const
+{
+	size_t memory = 0;
+	for (const auto & distanceMap : _distanceMaps)
+	{
+		memory += distanceMap->getMemoryUsage();
+	}
+
+	return memory;
+}
+
+int MapTools::getDistanceMapCacheHits() const
+{
+	return _distanceMapHits;
+}
+
+int MapTools::getDistanceMapCacheMisses() const
+{
+	return _distanceMapMisses;
 }
\ No newline at end of file
@@ -2,11 +2,16 @@
 
 #include "Common.h"
 #include <vector>
+#include <list>
 #include <BWAPI/Position.h>
 #include "DistanceMap.h"
+#include "RegionGraph.h"
+#include "PathFinder.h"
+#include "MapAnalysisFile.h"
 #include "Logger.h"
 #include "OpponentView.h"
 #include "MapInformation.h"
+#include "BotConfiguration.h"
 
 namespace UAlbertaBot
 {
@@ -17,25 +22,42 @@ class MapTools
     size_t _height;
 
     // a cache of already computed distance maps, which is mutable since it only acts as a cache
-    mutable std::map<BWAPI::TilePosition, DistanceMap>   _allMaps;
+    // the maps are kept most recently used first, once they use more than the configured memory the least
+    // recently used one is recomputed in place for the next tile asked about instead of allocating a new one,
+    // unless a caller still holds it, then it only leaves the cache and keeps the distances the caller was given
+    typedef std::list<std::shared_ptr<DistanceMap>> DistanceMapList;
+    mutable DistanceMapList                                          _distanceMaps;
+    mutable std::map<BWAPI::TilePosition, DistanceMapList::iterator> _distanceMapIndex;
+    mutable int                                                      _distanceMapHits;
+    mutable int                                                      _distanceMapMisses;
+    size_t                                                           _distanceMapMemoryLimit;
+	RegionGraph                                                      _regionGraph;     // answers ground distances between walkable tiles once onStart has computed it
+	mutable PathFinder                                               _pathFinder;      // ground paths on the region graph, mutable since it only caches routes
 	std::shared_ptr<AKBot::Logger> _logger;
+	std::string _mapAnalysisReadDir;
+	std::string _mapAnalysisWriteDir;
+	int _lastSeenUpdateInterval;
+	double _lastUpdateTime;
 	shared_ptr<AKBot::MapInformation> _mapInformation;
+	shared_ptr<AKBot::OpponentView> _opponentView;
 
     std::vector<std::vector<bool>> _walkable;               // the map stored at TilePosition resolution, values are 0/1 for walkable or not walkable
     std::vector<std::vector<bool>> _buildable;         // whether a tile is buildable (includes static resources)
     std::vector<std::vector<bool>> _depotBuildable;    // whether a depot is buildable on a tile (illegal within 3 tiles of static resource)
-    std::vector<std::vector<int>>  _lastSeen;          // the last time any of our units has seen this position on the map
+    std::vector<int>               _lastSeen;          // the last time any of our units has seen this position on the map, stored row by row
     std::vector<std::vector<int>>  _sectorNumber;      // connectivity sector number, two tiles are ground connected if they have the same number
     
     void setBWAPIMapData();                 // reads in the map data from bwapi and stores it in our map format
     void computeConnectivity();
+    bool readMapAnalysis(const std::string & filename);     // loads everything onStart computes from a file written by writeMapAnalysis
+    void writeMapAnalysis(const std::string & filename) const;
 
     const int & getSectorNumber(const BWAPI::TilePosition & tile) const;
     int & getSectorNumber(const BWAPI::TilePosition & tile);
     
 public:
 
-    MapTools(shared_ptr<AKBot::MapInformation> mapInformation, std::shared_ptr<AKBot::Logger> logger);
+    MapTools(shared_ptr<AKBot::OpponentView> opponentView, shared_ptr<AKBot::MapInformation> mapInformation, std::shared_ptr<AKBot::Logger> logger, const BotToolsConfiguration& toolsConfiguration);
 
 	const size_t getWidth() const { return _width; };
 	const size_t getHeight() const { return _height; };
@@ -43,10 +65,21 @@ public:
     void                    onStart();
     void                    update(int currentFrame);
     
-    const DistanceMap &     getDistanceMap(const BWAPI::Position & pos) const;
-    const DistanceMap &     getDistanceMap(const BWAPI::TilePosition & tile) const;
+    // the returned map keeps the distances from its tile for as long as the caller holds it
+    // a tile that isn't cached is computed right away by a BFS over the whole map, on the frame it is asked
+    // about, since callers need the complete map back. code that asks about many new tiles each frame should
+    // use getApproxGroundDistance or getPath, which don't run a BFS for walkable tiles
+    std::shared_ptr<const DistanceMap> getDistanceMap(const BWAPI::Position & pos) const;
+    std::shared_ptr<const DistanceMap> getDistanceMap(const BWAPI::TilePosition & tile) const;
+    // exact ground distance in tiles from the distance map of dest, -1 if there is no ground path
     int                     getGroundDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const;
     int                     getGroundDistance(const BWAPI::Position & src, const BWAPI::Position & dest) const;
+    // the region graph's distance between walkable tiles, an upper bound that can be a few tiles longer than the
+    // shortest path, and the exact distance otherwise. only for callers that don't compare it with exact distances
+    int                     getApproxGroundDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const;
+    int                     getApproxGroundDistance(const BWAPI::Position & src, const BWAPI::Position & dest) const;
+    bool                    getPath(const BWAPI::Position & src, const BWAPI::Position & dest, std::vector<BWAPI::Position> & path) const;
+    BWAPI::Position         getNextWaypoint(const BWAPI::Position & src, const BWAPI::Position & dest) const;
     bool                    isConnected(const BWAPI::TilePosition & from, const BWAPI::TilePosition & to) const;
     bool                    isConnected(const BWAPI::Position & from, const BWAPI::Position & to) const;
     bool                    isWalkable(const BWAPI::TilePosition & tile) const;
@@ -55,12 +88,21 @@ public:
     bool                    isBuildable(BWAPI::TilePosition tile, BWAPI::UnitType type) const;
     bool                    isBuildableTile(BWAPI::TilePosition tile) const;
     bool                    isDepotBuildableTile(BWAPI::TilePosition tile) const;
+    const RegionGraph &     getRegionGraph() const;
+    const PathFinder &      getPathFinder() const;
     
 
     // returns a list of all tiles on the map, sorted by 4-direcitonal walk distance from the given position
-    const std::vector<BWAPI::TilePosition> & getClosestTilesTo(const BWAPI::TilePosition & tile) const;
-    const std::vector<BWAPI::TilePosition> & getClosestTilesTo(BWAPI::Position pos) const;
+    // the list holds on to its distance map, so it stays valid for as long as the caller keeps it
+    std::shared_ptr<const std::vector<BWAPI::TilePosition>> getClosestTilesTo(const BWAPI::TilePosition & tile) const;
+    std::shared_ptr<const std::vector<BWAPI::TilePosition>> getClosestTilesTo(BWAPI::Position pos) const;
 	int getLastSeen(int x, int y) const;
+	double getLastUpdateTime() const;                     // milliseconds the last update took
+
+    size_t                  getNumCachedDistanceMaps() const;
+    size_t                  getDistanceMapCacheMemory() const;
+    int                     getDistanceMapCacheHits() const;
+    int                     getDistanceMapCacheMisses() const;
 };
 
 }
\ No newline at end of file
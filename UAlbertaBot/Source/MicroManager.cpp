@@ -133,14 +133,15 @@ void MicroManager::regroup(shared_ptr<MapTools> map, const BWAPI::Position & reg
         int unitDistanceFromBase = map->getGroundDistance(unit->getPosition(), ourBasePosition);
 
 		// if the unit is outside the regroup area
+        // ground units follow the waypoints of a ground path, so they don't head into a dead end on the way
         if (unitDistanceFromBase > regroupDistanceFromBase)
         {
-            Micro::SmartMove(unit, ourBasePosition, currentFrame);
+            Micro::SmartMove(unit, unit->isFlying() ? ourBasePosition : map->getNextWaypoint(unit->getPosition(), ourBasePosition), currentFrame);
         }
 		else if (unit->getDistance(regroupPosition) > 100)
 		{
 			// regroup it
-			Micro::SmartMove(unit, regroupPosition, currentFrame);
+			Micro::SmartMove(unit, unit->isFlying() ? regroupPosition : map->getNextWaypoint(unit->getPosition(), regroupPosition), currentFrame);
 		}
 		else
 		{
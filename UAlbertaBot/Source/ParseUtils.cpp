@@ -140,6 +140,9 @@ void UAlbertaBot::ParseUtils::ParseConfigFile(
         const rapidjson::Value & macro = doc["Macro"];
 		auto& macroOptions = config.Macro;
         JSONTools::ReadInt("BOSSFrameLimit", macro, macroOptions.BOSSFrameLimit);
+        JSONTools::ReadBool("BOSSSearchThread", macro, macroOptions.BOSSSearchThread);
+        JSONTools::ReadString("BOSSCacheReadFile", macro, macroOptions.BOSSCacheReadFile);
+        JSONTools::ReadString("BOSSCacheWriteFile", macro, macroOptions.BOSSCacheWriteFile);
         JSONTools::ReadInt("BuildingSpacing", macro, macroOptions.BuildingSpacing);
         JSONTools::ReadInt("PylongSpacing", macro, macroOptions.PylonSpacing);
         JSONTools::ReadInt("WorkersPerRefinery", macro, macroOptions.WorkersPerRefinery);
@@ -197,6 +200,12 @@ void UAlbertaBot::ParseUtils::ParseConfigFile(
 		auto& toolsOptions = config.Tools;
 
         JSONTools::ReadInt("MapGridSize", tool, toolsOptions.MAP_GRID_SIZE);
+        JSONTools::ReadInt("DistanceMapCacheMB", tool, toolsOptions.DistanceMapCacheMB);
+        JSONTools::ReadString("MapAnalysisReadDirectory", tool, toolsOptions.MapAnalysisReadDir);
+        JSONTools::ReadString("MapAnalysisWriteDirectory", tool, toolsOptions.MapAnalysisWriteDir);
+        JSONTools::ReadInt("LastSeenUpdateFrames", tool, toolsOptions.LastSeenUpdateFrames);
+        JSONTools::ReadInt("PathSearchesPerFrame", tool, toolsOptions.PathSearchesPerFrame);
+        JSONTools::ReadInt("PathCacheSize", tool, toolsOptions.PathCacheSize);
     }
 
     // Parse the SparCraft Options
@@ -0,0 +1,154 @@
+#include "PathFinder.h"
+
+using namespace UAlbertaBot;
+
+PathFinder::PathFinder(const RegionGraph & regionGraph, int searchesPerFrame, size_t maxCachedRoutes)
+    : _regionGraph      (regionGraph)
+    , _searchesPerFrame (searchesPerFrame)
+    , _maxCachedRoutes  (maxCachedRoutes > 0 ? maxCachedRoutes : 1)
+    , _searchesLeft     (searchesPerFrame)
+    , _cacheHits        (0)
+    , _cacheMisses      (0)
+{
+
+}
+
+void PathFinder::onFrame()
+{
+    _searchesLeft = _searchesPerFrame;
+}
+
+// the cached route between two portals, searching for it if there are searches left this frame
+const std::vector<int> * PathFinder::getRoute(int fromPortal, int toPortal)
+{
+    const PortalPair key(fromPortal, toPortal);
+
+    auto found = _routeIndex.find(key);
+    if (found != _routeIndex.end())
+    {
+        ++_cacheHits;
+        _routes.splice(_routes.begin(), _routes, found->second);
+        return &_routes.front().second;
+    }
+
+    if (_searchesLeft <= 0)
+    {
+        return nullptr;
+    }
+
+    --_searchesLeft;
+    ++_cacheMisses;
+
+    // past the cache size the least recently used route is dropped to make room
+    if (_routes.size() >= _maxCachedRoutes)
+    {
+        _routeIndex.erase(_routes.back().first);
+        _routes.pop_back();
+    }
+
+    _routes.push_front(std::make_pair(key, std::vector<int>()));
+    _regionGraph.getPortalPath(fromPortal, toPortal, _routes.front().second);
+    _routeIndex[key] = _routes.begin();
+
+    return &_routes.front().second;
+}
+
+bool PathFinder::getPath(const BWAPI::Position & src, const BWAPI::Position & dest, std::vector<BWAPI::Position> & path)
+{
+    path.clear();
+
+    if (!_regionGraph.isComputed() || !src.isValid() || !dest.isValid())
+    {
+        return false;
+    }
+
+    const BWAPI::TilePosition srcTile(src);
+    const BWAPI::TilePosition destTile(dest);
+    const int srcRegion = _regionGraph.getRegion(srcTile);
+    const int destRegion = _regionGraph.getRegion(destTile);
+    int srcPortal = -1, destPortal = -1;
+
+    if (srcRegion == -1 || destRegion == -1)
+    {
+        return false;
+    }
+
+    // a tile in the same region as the destination may have a way there inside the region, which costs a search too
+    if (srcRegion == destRegion)
+    {
+        if (_searchesLeft <= 0)
+        {
+            return false;
+        }
+
+        --_searchesLeft;
+    }
+
+    if (_regionGraph.getDistance(srcTile, destTile, srcPortal, destPortal) == -1)
+    {
+        return false;
+    }
+
+    // the tiles share a region and the way inside it is shortest
+    if (srcPortal == -1)
+    {
+        path.push_back(dest);
+        return true;
+    }
+
+    const std::vector<int> * route = getRoute(srcPortal, destPortal);
+    if (route == nullptr || route->empty())
+    {
+        return false;
+    }
+
+    // a portal followed by the one across its entrance is where the path changes region, only the far side is kept
+    const std::vector<RegionGraph::Portal> & portals = _regionGraph.getPortals();
+    for (size_t i = 0; i < route->size(); ++i)
+    {
+        if (i + 1 < route->size() && portals[(*route)[i + 1]].region != portals[(*route)[i]].region)
+        {
+            continue;
+        }
+
+        path.push_back(BWAPI::Position(portals[(*route)[i]].tile) + BWAPI::Position(16, 16));
+    }
+
+    path.push_back(dest);
+    return true;
+}
+
+BWAPI::Position PathFinder::getNextWaypoint(const BWAPI::Position & src, const BWAPI::Position & dest, int reachedDistance)
+{
+    std::vector<BWAPI::Position> path;
+
+    if (!getPath(src, dest, path))
+    {
+        return dest;
+    }
+
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+        if (src.getApproxDistance(path[i]) > reachedDistance)
+        {
+            return path[i];
+        }
+    }
+
+    return dest;
+}
+
+size_t PathFinder::getNumCachedRoutes() const
+{
+    return _routes.size();
+}
+
+int PathFinder::getCacheHits() const
+{
+    return _cacheHits;
+}
+
+int PathFinder::getCacheMisses() const
+{
+    return _cacheMisses;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <map>
+#include <utility>
+#include <BWAPI/Position.h>
+#include "RegionGraph.h"
+
+namespace UAlbertaBot
+{
+
+// ground paths as a list of waypoints, found on a RegionGraph
+// a path leaves the source region by the portal the graph's shortest distance uses, goes through the portals on the
+// way and ends at the destination, with a waypoint where the path crosses from one region into the next
+// the portal routes are cached by the pair of portals they join, so units spread over one region going to the same
+// place share an entry. a route that isn't cached costs a search, and only so many searches are done each frame
+class PathFinder
+{
+    typedef std::pair<int, int> PortalPair;
+    typedef std::list<std::pair<PortalPair, std::vector<int>>> RouteList;
+
+    const RegionGraph &                 _regionGraph;
+    int                                 _searchesPerFrame;
+    size_t                              _maxCachedRoutes;
+
+    int                                 _searchesLeft;
+    RouteList                           _routes;            // most recently used first
+    std::map<PortalPair, RouteList::iterator> _routeIndex;
+    int                                 _cacheHits;
+    int                                 _cacheMisses;
+
+    const std::vector<int> *            getRoute(int fromPortal, int toPortal);
+
+public:
+
+    PathFinder(const RegionGraph & regionGraph, int searchesPerFrame, size_t maxCachedRoutes);
+
+    // starts a new frame's search budget
+    void                                onFrame();
+
+    // fills path with the waypoints from src to dest, the last one being dest. false if there is no ground path,
+    // either position isn't on a walkable tile, or the route isn't cached and this frame's searches are used up
+    bool                                getPath(const BWAPI::Position & src, const BWAPI::Position & dest, std::vector<BWAPI::Position> & path);
+
+    // the first waypoint on the path that is further than reachedDistance from src, or dest if there is no path
+    BWAPI::Position                     getNextWaypoint(const BWAPI::Position & src, const BWAPI::Position & dest, int reachedDistance);
+
+    size_t                              getNumCachedRoutes() const;
+    int                                 getCacheHits() const;
+    int                                 getCacheMisses() const;
+};
+
+}
@@ -0,0 +1,554 @@
+#include "RegionGraph.h"
+#include "UABAssert.h"
+#include <queue>
+#include <limits>
+#include <functional>
+#include <algorithm>
+
+using namespace UAlbertaBot;
+
+const size_t LegalActions = 4;
+const int actionX[LegalActions] = {1, -1, 0, 0};
+const int actionY[LegalActions] = {0, 0, 1, -1};
+
+// the distance stored for tiles a portal doesn't reach
+const unsigned short Unreachable = 0xFFFF;
+
+const int RegionTiles = RegionGraph::RegionSize * RegionGraph::RegionSize;
+
+RegionGraph::RegionGraph()
+    : _width    (0)
+    , _height   (0)
+{
+
+}
+
+void RegionGraph::compute(int width, int height, const std::vector<std::vector<bool>> & walkable)
+{
+    _width = width;
+    _height = height;
+    _tileRegion.assign(width * height, -1);
+    _regions.clear();
+    _portals.clear();
+    _portalDistances.clear();
+    _localDistances.assign(RegionTiles, Unreachable);
+    _localFringe.reserve(RegionTiles);
+
+    PortalEdges edges;
+
+    computeRegions(walkable);
+    computePortals(edges);
+    computeRegionDistances(edges);
+    computePortalDistances(edges);
+}
+
+bool RegionGraph::isComputed() const
+{
+    return !_tileRegion.empty();
+}
+
+// flood fills the walkable tiles of each block, every fill is a new region
+void RegionGraph::computeRegions(const std::vector<std::vector<bool>> & walkable)
+{
+    std::vector<BWAPI::TilePosition> fringe;
+    fringe.reserve(RegionTiles);
+
+    for (int blockY = 0; blockY < _height; blockY += RegionSize)
+    {
+        for (int blockX = 0; blockX < _width; blockX += RegionSize)
+        {
+            const int endX = (blockX + RegionSize < _width) ? (blockX + RegionSize) : _width;
+            const int endY = (blockY + RegionSize < _height) ? (blockY + RegionSize) : _height;
+
+            for (int x = blockX; x < endX; ++x)
+            {
+                for (int y = blockY; y < endY; ++y)
+                {
+                    if (!walkable[x][y] || _tileRegion[y * _width + x] != -1)
+                    {
+                        continue;
+                    }
+
+                    const int region = (int)_regions.size();
+                    _regions.push_back(Region());
+                    _regions.back().topLeft = BWAPI::TilePosition(blockX, blockY);
+
+                    fringe.clear();
+                    fringe.push_back(BWAPI::TilePosition(x, y));
+                    _tileRegion[y * _width + x] = region;
+
+                    for (size_t fringeIndex = 0; fringeIndex < fringe.size(); ++fringeIndex)
+                    {
+                        const BWAPI::TilePosition tile = fringe[fringeIndex];
+
+                        for (size_t a = 0; a < LegalActions; ++a)
+                        {
+                            BWAPI::TilePosition nextTile(tile.x + actionX[a], tile.y + actionY[a]);
+
+                            // the fill stays inside the block
+                            if (nextTile.x < blockX || nextTile.y < blockY || nextTile.x >= endX || nextTile.y >= endY)
+                            {
+                                continue;
+                            }
+
+                            if (walkable[nextTile.x][nextTile.y] && _tileRegion[nextTile.y * _width + nextTile.x] == -1)
+                            {
+                                _tileRegion[nextTile.y * _width + nextTile.x] = region;
+                                fringe.push_back(nextTile);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// walks along every block edge and cuts the walkable tiles on both sides of it into entrances
+void RegionGraph::computePortals(PortalEdges & edges)
+{
+    // each edge is walked from its first tile, step moves along the edge and across moves over it
+    for (int vertical = 0; vertical < 2; ++vertical)
+    {
+        const BWAPI::TilePosition step   = vertical ? BWAPI::TilePosition(0, 1) : BWAPI::TilePosition(1, 0);
+        const BWAPI::TilePosition across = vertical ? BWAPI::TilePosition(1, 0) : BWAPI::TilePosition(0, 1);
+        const int numEdges = vertical ? _width : _height;
+        const int edgeLength = vertical ? _height : _width;
+
+        for (int edge = RegionSize; edge < numEdges; edge += RegionSize)
+        {
+            BWAPI::TilePosition entranceStart;
+            int entranceLength = 0;
+            int entranceRegion = -1;
+            int entranceAcrossRegion = -1;
+
+            for (int i = 0; i <= edgeLength; ++i)
+            {
+                const BWAPI::TilePosition tile(across.x * (edge - 1) + step.x * i, across.y * (edge - 1) + step.y * i);
+                const bool onEdge = i < edgeLength;
+                const int region = onEdge ? getRegion(tile) : -1;
+                const int acrossRegion = onEdge ? getRegion(BWAPI::TilePosition(tile.x + across.x, tile.y + across.y)) : -1;
+
+                // the entrance ends where either side stops being walkable, the regions change, or it gets too wide
+                if (entranceLength > 0 && (region != entranceRegion || acrossRegion != entranceAcrossRegion || entranceLength == MaxEntranceWidth))
+                {
+                    addEntrance(entranceStart, step, across, entranceLength, edges);
+                    entranceLength = 0;
+                }
+
+                if (region == -1 || acrossRegion == -1)
+                {
+                    continue;
+                }
+
+                if (entranceLength == 0)
+                {
+                    entranceStart = tile;
+                    entranceRegion = region;
+                    entranceAcrossRegion = acrossRegion;
+                }
+
+                ++entranceLength;
+            }
+        }
+    }
+}
+
+// puts a portal on both sides of the middle of the entrance, one step apart
+void RegionGraph::addEntrance(const BWAPI::TilePosition & from, const BWAPI::TilePosition & step, const BWAPI::TilePosition & across, int length, PortalEdges & edges)
+{
+    const BWAPI::TilePosition middle(from.x + step.x * (length / 2), from.y + step.y * (length / 2));
+    const BWAPI::TilePosition acrossMiddle(middle.x + across.x, middle.y + across.y);
+
+    const int portal = (int)_portals.size();
+    const BWAPI::TilePosition tiles[2] = { middle, acrossMiddle };
+
+    for (int side = 0; side < 2; ++side)
+    {
+        Portal p;
+        p.tile = tiles[side];
+        p.region = getRegion(tiles[side]);
+        p.index = (int)_regions[p.region].portals.size();
+
+        _regions[p.region].portals.push_back(portal + side);
+        _portals.push_back(p);
+    }
+
+    edges.resize(_portals.size());
+    edges[portal].push_back(std::pair<int, int>(portal + 1, 1));
+    edges[portal + 1].push_back(std::pair<int, int>(portal, 1));
+}
+
+// a BFS inside the region from each of its portals, which also gives the distances between the region's portals
+void RegionGraph::computeRegionDistances(PortalEdges & edges)
+{
+    std::vector<BWAPI::TilePosition> fringe;
+    fringe.reserve(RegionTiles);
+
+    for (int r = 0; r < (int)_regions.size(); ++r)
+    {
+        Region & region = _regions[r];
+        region.portalDistances.assign(region.portals.size() * RegionTiles, Unreachable);
+
+        for (size_t p = 0; p < region.portals.size(); ++p)
+        {
+            unsigned short * distances = &region.portalDistances[p * RegionTiles];
+            const BWAPI::TilePosition & portalTile = _portals[region.portals[p]].tile;
+
+            fringe.clear();
+            fringe.push_back(portalTile);
+            distances[getLocalIndex(region, portalTile)] = 0;
+
+            for (size_t fringeIndex = 0; fringeIndex < fringe.size(); ++fringeIndex)
+            {
+                const BWAPI::TilePosition tile = fringe[fringeIndex];
+                const unsigned short tileDistance = distances[getLocalIndex(region, tile)];
+
+                for (size_t a = 0; a < LegalActions; ++a)
+                {
+                    BWAPI::TilePosition nextTile(tile.x + actionX[a], tile.y + actionY[a]);
+
+                    if (getRegion(nextTile) == r && distances[getLocalIndex(region, nextTile)] == Unreachable)
+                    {
+                        distances[getLocalIndex(region, nextTile)] = tileDistance + 1;
+                        fringe.push_back(nextTile);
+                    }
+                }
+            }
+
+            for (size_t other = 0; other < region.portals.size(); ++other)
+            {
+                const unsigned short distance = distances[getLocalIndex(region, _portals[region.portals[other]].tile)];
+
+                if (other != p && distance != Unreachable)
+                {
+                    edges[region.portals[p]].push_back(std::pair<int, int>(region.portals[other], distance));
+                }
+            }
+        }
+    }
+}
+
+// Dijkstra from every portal over the portal graph
+void RegionGraph::computePortalDistances(const PortalEdges & edges)
+{
+    typedef std::pair<int, int> DistancePortal;
+
+    const int numPortals = (int)_portals.size();
+    _portalDistances.assign(numPortals * numPortals, Unreachable);
+
+    std::priority_queue<DistancePortal, std::vector<DistancePortal>, std::greater<DistancePortal>> open;
+    std::vector<int> bestFound(numPortals);
+
+    for (int source = 0; source < numPortals; ++source)
+    {
+        unsigned short * distances = &_portalDistances[source * numPortals];
+        std::fill(bestFound.begin(), bestFound.end(), std::numeric_limits<int>::max());
+
+        // a portal is only queued again when a shorter way to it is found
+        bestFound[source] = 0;
+        open.push(DistancePortal(0, source));
+
+        while (!open.empty())
+        {
+            const DistancePortal top = open.top();
+            open.pop();
+
+            if (distances[top.second] != Unreachable)
+            {
+                continue;
+            }
+
+            UAB_ASSERT(top.first < Unreachable, "Portal distance doesn't fit in an unsigned short: %d", top.first);
+            distances[top.second] = (unsigned short)top.first;
+
+            for (size_t e = 0; e < edges[top.second].size(); ++e)
+            {
+                const std::pair<int, int> & edge = edges[top.second][e];
+
+                if (top.first + edge.second < bestFound[edge.first])
+                {
+                    bestFound[edge.first] = top.first + edge.second;
+                    open.push(DistancePortal(bestFound[edge.first], edge.first));
+                }
+            }
+        }
+    }
+}
+
+void RegionGraph::write(MapAnalysisWriter & writer) const
+{
+    writer.write(_width);
+    writer.write(_height);
+    writer.write((int)RegionSize);
+    writer.write((int)MaxEntranceWidth);
+    writer.write(_tileRegion);
+
+    writer.write((int)_regions.size());
+    for (size_t r = 0; r < _regions.size(); ++r)
+    {
+        writer.write(_regions[r].topLeft.x);
+        writer.write(_regions[r].topLeft.y);
+        writer.write(_regions[r].portals);
+        writer.write(_regions[r].portalDistances);
+    }
+
+    writer.write((int)_portals.size());
+    for (size_t p = 0; p < _portals.size(); ++p)
+    {
+        writer.write(_portals[p].tile.x);
+        writer.write(_portals[p].tile.y);
+        writer.write(_portals[p].region);
+        writer.write(_portals[p].index);
+    }
+
+    writer.write(_portalDistances);
+}
+
+bool RegionGraph::read(MapAnalysisReader & reader)
+{
+    int regionSize = 0, maxEntranceWidth = 0, numRegions = 0, numPortals = 0;
+
+    bool ok = reader.read(_width) && reader.read(_height) && reader.read(regionSize) && reader.read(maxEntranceWidth) &&
+              regionSize == RegionSize && maxEntranceWidth == MaxEntranceWidth &&
+              reader.read(_tileRegion) && _tileRegion.size() == (size_t)(_width * _height) && reader.read(numRegions) && numRegions >= 0;
+
+    _regions.assign(ok ? numRegions : 0, Region());
+    for (size_t r = 0; ok && r < _regions.size(); ++r)
+    {
+        ok = reader.read(_regions[r].topLeft.x) && reader.read(_regions[r].topLeft.y) &&
+             reader.read(_regions[r].portals) && reader.read(_regions[r].portalDistances) &&
+             _regions[r].portalDistances.size() == _regions[r].portals.size() * RegionTiles;
+    }
+
+    ok = ok && reader.read(numPortals) && numPortals >= 0;
+    _portals.assign(ok ? numPortals : 0, Portal());
+    for (size_t p = 0; ok && p < _portals.size(); ++p)
+    {
+        ok = reader.read(_portals[p].tile.x) && reader.read(_portals[p].tile.y) &&
+             reader.read(_portals[p].region) && reader.read(_portals[p].index);
+    }
+
+    ok = ok && reader.read(_portalDistances) && _portalDistances.size() == _portals.size() * _portals.size();
+
+    if (!ok)
+    {
+        _tileRegion.clear();
+        _regions.clear();
+        _portals.clear();
+        _portalDistances.clear();
+        return false;
+    }
+
+    _localDistances.assign(RegionTiles, Unreachable);
+    _localFringe.reserve(RegionTiles);
+    return true;
+}
+
+int RegionGraph::getLocalIndex(const Region & region, const BWAPI::TilePosition & tile) const
+{
+    return (tile.x - region.topLeft.x) + (tile.y - region.topLeft.y) * RegionSize;
+}
+
+// a BFS inside the region for tiles that share one, the region is small enough for this to be cheap
+int RegionGraph::getLocalDistance(int region, const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const
+{
+    const Region & r = _regions[region];
+    const int destIndex = getLocalIndex(r, dest);
+    int distance = -1;
+
+    _localFringe.clear();
+    _localFringe.push_back(getLocalIndex(r, src));
+    _localDistances[_localFringe.back()] = 0;
+
+    for (size_t fringeIndex = 0; fringeIndex < _localFringe.size(); ++fringeIndex)
+    {
+        const int index = _localFringe[fringeIndex];
+
+        if (index == destIndex)
+        {
+            distance = _localDistances[index];
+            break;
+        }
+
+        const BWAPI::TilePosition tile(r.topLeft.x + index % RegionSize, r.topLeft.y + index / RegionSize);
+
+        for (size_t a = 0; a < LegalActions; ++a)
+        {
+            BWAPI::TilePosition nextTile(tile.x + actionX[a], tile.y + actionY[a]);
+
+            if (getRegion(nextTile) == region && _localDistances[getLocalIndex(r, nextTile)] == Unreachable)
+            {
+                _localDistances[getLocalIndex(r, nextTile)] = _localDistances[index] + 1;
+                _localFringe.push_back(getLocalIndex(r, nextTile));
+            }
+        }
+    }
+
+    // only the tiles the search touched need clearing for the next one
+    for (size_t i = 0; i < _localFringe.size(); ++i)
+    {
+        _localDistances[_localFringe[i]] = Unreachable;
+    }
+
+    return distance;
+}
+
+int RegionGraph::getDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const
+{
+    int srcPortal = -1, destPortal = -1;
+
+    return getDistance(src, dest, srcPortal, destPortal);
+}
+
+int RegionGraph::getDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest, int & srcPortal, int & destPortal) const
+{
+    UAB_ASSERT(isComputed(), "Region graph queried before it was computed");
+
+    const int srcRegion = getRegion(src);
+    const int destRegion = getRegion(dest);
+
+    srcPortal = -1;
+    destPortal = -1;
+
+    if (srcRegion == -1 || destRegion == -1)
+    {
+        return -1;
+    }
+
+    int best = std::numeric_limits<int>::max();
+
+    if (srcRegion == destRegion)
+    {
+        const int localDistance = getLocalDistance(srcRegion, src, dest);
+        best = (localDistance == -1) ? best : localDistance;
+    }
+
+    // the shortest path may still leave the region, so the portals are always tried
+    const Region & from = _regions[srcRegion];
+    const Region & to = _regions[destRegion];
+    const int srcIndex = getLocalIndex(from, src);
+    const int destIndex = getLocalIndex(to, dest);
+    const int numPortals = (int)_portals.size();
+
+    for (size_t p = 0; p < from.portals.size(); ++p)
+    {
+        const unsigned short srcDistance = from.portalDistances[p * RegionTiles + srcIndex];
+
+        if (srcDistance == Unreachable)
+        {
+            continue;
+        }
+
+        const unsigned short * portalDistances = &_portalDistances[from.portals[p] * numPortals];
+
+        for (size_t q = 0; q < to.portals.size(); ++q)
+        {
+            const unsigned short destDistance = to.portalDistances[q * RegionTiles + destIndex];
+            const unsigned short portalDistance = portalDistances[to.portals[q]];
+
+            if (destDistance == Unreachable || portalDistance == Unreachable)
+            {
+                continue;
+            }
+
+            const int distance = srcDistance + portalDistance + destDistance;
+
+            if (distance < best)
+            {
+                best = distance;
+                srcPortal = from.portals[p];
+                destPortal = to.portals[q];
+            }
+        }
+    }
+
+    return (best == std::numeric_limits<int>::max()) ? -1 : best;
+}
+
+// walks from portal to portal, always to a neighbour that is on a shortest path to the last portal
+// a portal's neighbours are the portal across its entrance and the other portals of its region
+void RegionGraph::getPortalPath(int fromPortal, int toPortal, std::vector<int> & portals) const
+{
+    const int numPortals = (int)_portals.size();
+
+    portals.clear();
+
+    if (_portalDistances[fromPortal * numPortals + toPortal] == Unreachable)
+    {
+        return;
+    }
+
+    portals.push_back(fromPortal);
+
+    while (portals.back() != toPortal && (int)portals.size() <= numPortals)
+    {
+        const int current = portals.back();
+        const int distanceLeft = _portalDistances[current * numPortals + toPortal];
+        const Region & region = _regions[_portals[current].region];
+        const int currentIndex = getLocalIndex(region, _portals[current].tile);
+
+        // portals are made in pairs, one on each side of an entrance
+        int next = current ^ 1;
+
+        if (_portalDistances[next * numPortals + toPortal] == Unreachable || 1 + _portalDistances[next * numPortals + toPortal] != distanceLeft)
+        {
+            next = -1;
+
+            for (size_t p = 0; p < region.portals.size(); ++p)
+            {
+                const int portal = region.portals[p];
+                const unsigned short step = region.portalDistances[p * RegionTiles + currentIndex];
+
+                // two portals can share a tile, the path must not go back and forth between them
+                if (portal == current || step == Unreachable || _portalDistances[portal * numPortals + toPortal] == Unreachable ||
+                    std::find(portals.begin(), portals.end(), portal) != portals.end())
+                {
+                    continue;
+                }
+
+                if (step + _portalDistances[portal * numPortals + toPortal] == distanceLeft)
+                {
+                    next = portal;
+                    break;
+                }
+            }
+        }
+
+        UAB_ASSERT(next != -1, "No next portal on a shortest portal path");
+        if (next == -1)
+        {
+            portals.clear();
+            return;
+        }
+
+        portals.push_back(next);
+    }
+}
+
+int RegionGraph::getRegion(const BWAPI::TilePosition & tile) const
+{
+    if (tile.x < 0 || tile.y < 0 || tile.x >= _width || tile.y >= _height)
+    {
+        return -1;
+    }
+
+    return _tileRegion[tile.y * _width + tile.x];
+}
+
+int RegionGraph::getPortalDistance(int fromPortal, int toPortal) const
+{
+    const unsigned short distance = _portalDistances[fromPortal * _portals.size() + toPortal];
+
+    return (distance == Unreachable) ? -1 : distance;
+}
+
+const std::vector<RegionGraph::Region> & RegionGraph::getRegions() const
+{
+    return _regions;
+}
+
+const std::vector<RegionGraph::Portal> & RegionGraph::getPortals() const
+{
+    return _portals;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <BWAPI/Position.h>
+#include "MapAnalysisFile.h"
+
+namespace UAlbertaBot
+{
+
+// an abstraction of the walkable tiles of the map used to answer ground distance queries without a BFS per destination
+// the map is cut into square blocks of RegionSize tiles and every 4-connected group of walkable tiles inside a block
+// is a region. where two regions touch across a block edge the touching tiles are split into entrances of at most
+// MaxEntranceWidth tiles, and the middle of each entrance gives a portal on either side of the edge
+// for every portal the graph knows the distance to each tile of its region and, through the other portals, the
+// shortest distance to every other portal on the map, so a distance is the best portal to portal route between the
+// two tiles' regions, which can be a few tiles longer than the true shortest path
+class RegionGraph
+{
+public:
+
+    static const int RegionSize = 32;
+    static const int MaxEntranceWidth = 8;
+
+    struct Portal
+    {
+        BWAPI::TilePosition tile;
+        int                 region;
+        int                 index;      // index of this portal in its region's portal list
+    };
+
+    struct Region
+    {
+        BWAPI::TilePosition topLeft;    // top left tile of the region's block
+        std::vector<int>    portals;
+
+        // distance from each portal of the region to each tile of its block, indexed by portal then tile
+        // a tile that isn't part of the region holds 0xFFFF
+        std::vector<unsigned short> portalDistances;
+    };
+
+private:
+
+    typedef std::vector<std::vector<std::pair<int, int>>> PortalEdges;     // per portal, the portals it leads to and how far
+
+    int                         _width;
+    int                         _height;
+    std::vector<int>            _tileRegion;        // region of each tile stored row by row, -1 if the tile isn't walkable
+    std::vector<Region>         _regions;
+    std::vector<Portal>         _portals;
+    std::vector<unsigned short> _portalDistances;   // shortest distance between every pair of portals, 0xFFFF if there is no path
+
+    // scratch space for the BFS inside a region, which is mutable since it only saves allocating on every query
+    mutable std::vector<unsigned short> _localDistances;
+    mutable std::vector<int>            _localFringe;
+
+    void computeRegions(const std::vector<std::vector<bool>> & walkable);
+    void computePortals(PortalEdges & edges);
+    void addEntrance(const BWAPI::TilePosition & from, const BWAPI::TilePosition & step, const BWAPI::TilePosition & across, int length, PortalEdges & edges);
+    void computeRegionDistances(PortalEdges & edges);
+    void computePortalDistances(const PortalEdges & edges);
+
+    int  getLocalIndex(const Region & region, const BWAPI::TilePosition & tile) const;
+    int  getLocalDistance(int region, const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const;
+
+public:
+
+    RegionGraph();
+
+    void compute(int width, int height, const std::vector<std::vector<bool>> & walkable);
+    bool isComputed() const;
+
+    // saves or loads a computed graph as part of a map analysis file, a graph that fails to load is left empty
+    void write(MapAnalysisWriter & writer) const;
+    bool read(MapAnalysisReader & reader);
+
+    // the ground distance in tiles between two walkable tiles, or -1 if there is no ground path between them
+    int  getDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest) const;
+
+    // as getDistance, also giving the portals the shortest route leaves the source region by and enters the destination
+    // region by, both are -1 if the tiles share a region and the way inside it is shortest
+    int  getDistance(const BWAPI::TilePosition & src, const BWAPI::TilePosition & dest, int & srcPortal, int & destPortal) const;
+
+    // the portals a shortest route between two portals goes through, both included, empty if there is no route
+    void getPortalPath(int fromPortal, int toPortal, std::vector<int> & portals) const;
+
+    // region of a tile, -1 if it isn't walkable
+    int  getRegion(const BWAPI::TilePosition & tile) const;
+    int  getPortalDistance(int fromPortal, int toPortal) const;     // -1 if there is no path
+
+    const std::vector<Region> & getRegions() const;
+    const std::vector<Portal> & getPortals() const;
+};
+
+}
@@ -114,7 +114,7 @@ bool ScoutManager::exploreEnemyBases(int currentFrame)
 		if (!BWAPI::Broodwar->isExplored(startLocation->getDepotTilePosition()))
 		{
 			// assign a zergling to go scout it
-			Micro::SmartMove(_workerScout, BWAPI::Position(startLocation->getDepotTilePosition()), currentFrame);
+			Micro::SmartMove(_workerScout, _mapTools->getNextWaypoint(_workerScout->getPosition(), BWAPI::Position(startLocation->getDepotTilePosition())), currentFrame);
 			return true;
 		}
 	}
@@ -183,7 +183,7 @@ void UAlbertaBot::ScoutManager::harrasEnemyBaseIfPossible(const UAlbertaBot::Bas
 		_scoutStatus = "Enemy region known, going there";
 
 		// move to the enemy region
-		Micro::SmartMove(_workerScout, enemyBaseLocation->getPosition(), currentFrame);
+		Micro::SmartMove(_workerScout, _mapTools->getNextWaypoint(_workerScout->getPosition(), enemyBaseLocation->getPosition()), currentFrame);
 	}
 }
 
@@ -44,7 +44,7 @@ void TransportManager::calculateMapEdgeVertices()
 	}
 
 	const BWAPI::Position basePosition = BWAPI::Position(opponentView->self()->getStartLocation());
-	const std::vector<BWAPI::TilePosition> & closestTobase = _mapTools->getClosestTilesTo(basePosition);
+	const std::shared_ptr<const std::vector<BWAPI::TilePosition>> closestTobase = _mapTools->getClosestTilesTo(basePosition);
 
 	std::set<BWAPI::Position> unsortedVertices;
 
@@ -52,7 +52,7 @@ void TransportManager::calculateMapEdgeVertices()
 	int maxX = std::numeric_limits<int>::min(); int maxY = maxX;
 
 	//compute mins and maxs
-	for(auto &tile : closestTobase)
+	for(auto &tile : *closestTobase)
 	{
 		if (tile.x > maxX) maxX = tile.x;
 		else if (tile.x < minX) minX = tile.x;
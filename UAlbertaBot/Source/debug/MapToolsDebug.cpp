@@ -19,6 +19,20 @@ namespace AKBot
 			return;
 		}
 
+		canvas.drawTextScreen(10, 320, "Distance maps: %d (%d KB), %d hits, %d misses",
+			(int)_map->getNumCachedDistanceMaps(),
+			(int)(_map->getDistanceMapCacheMemory() / 1024),
+			_map->getDistanceMapCacheHits(),
+			_map->getDistanceMapCacheMisses());
+		canvas.drawTextScreen(10, 330, "Region graph: %d regions, %d portals",
+			(int)_map->getRegionGraph().getRegions().size(),
+			(int)_map->getRegionGraph().getPortals().size());
+		canvas.drawTextScreen(10, 340, "Last seen update: %.3lf ms", _map->getLastUpdateTime());
+		canvas.drawTextScreen(10, 350, "Paths: %d routes cached, %d hits, %d misses",
+			(int)_map->getPathFinder().getNumCachedRoutes(),
+			_map->getPathFinder().getCacheHits(),
+			_map->getPathFinder().getCacheMisses());
+
 		bool rMouseState = BWAPI::Broodwar->getMouseState(BWAPI::MouseButton::M_RIGHT);
 		if (!rMouseState)
 		{
@@ -320,8 +320,11 @@ void HLState::applyAndForward(int depth, int frames, const std::array<HLMove, 2>
 		if (forwardedFrames + framesToForward>frames)
 		{
 			framesToForward = frames - forwardedFrames;
-			synchronizeNewUnits(0, _state[0].fastForward(_state[0].getCurrentFrame() + framesToForward));
-			synchronizeNewUnits(1, _state[1].fastForward(_state[1].getCurrentFrame() + framesToForward));
+			BOSS::FinishedActions finished[2];
+			_state[0].fastForward(_state[0].getCurrentFrame() + framesToForward, &finished[0]);
+			_state[1].fastForward(_state[1].getCurrentFrame() + framesToForward, &finished[1]);
+			synchronizeNewUnits(0, finished[0]);
+			synchronizeNewUnits(1, finished[1]);
 			if (framesToForward > 0)
 			{
 				forwardSquads(framesToForward);
@@ -333,7 +336,9 @@ void HLState::applyAndForward(int depth, int frames, const std::array<HLMove, 2>
 		//Logger::LogAppendToFile(UAB_LOGFILE, "Start new unit: %s to player %d frame %d\n", action.getName().c_str(), nextPlayer, _state[nextPlayer].getCurrentFrame());
 
 
-		synchronizeNewUnits(nextPlayer, _state[nextPlayer].doAction(action), action);
+		BOSS::FinishedActions finished;
+		_state[nextPlayer].doAction(action, &finished);
+		synchronizeNewUnits(nextPlayer, finished, action);
 		if (checkChoicePoint(moves[1 - nextPlayer], 1 - nextPlayer))
 		{
 			//Logger::LogAppendToFile(UAB_LOGFILE, "Hit choice point while forwarding 1\n");
@@ -344,7 +349,9 @@ void HLState::applyAndForward(int depth, int frames, const std::array<HLMove, 2>
 			const BOSS::ActionType& action = buildOrder[1 - nextPlayer][buildOrderIndex[1 - nextPlayer]++];
 			//Logger::LogAppendToFile(UAB_LOGFILE, "Start new unit: %s to player %d frame %d\n", action.getName().c_str(), 1 - nextPlayer, _state[1 - nextPlayer].getCurrentFrame());
 
-			synchronizeNewUnits(1 - nextPlayer, _state[1 - nextPlayer].doAction(action), action);
+			BOSS::FinishedActions otherFinished;
+			_state[1 - nextPlayer].doAction(action, &otherFinished);
+			synchronizeNewUnits(1 - nextPlayer, otherFinished, action);
 			if (checkChoicePoint(moves[nextPlayer], nextPlayer))
 			{
 				//Logger::LogAppendToFile(UAB_LOGFILE, "Hit choice point while forwarding 1\n");
@@ -353,7 +360,9 @@ void HLState::applyAndForward(int depth, int frames, const std::array<HLMove, 2>
 		}
 		else{
 
-			synchronizeNewUnits(1 - nextPlayer, _state[1 - nextPlayer].fastForward(nextActionStart[nextPlayer]));
+			BOSS::FinishedActions otherFinished;
+			_state[1 - nextPlayer].fastForward(nextActionStart[nextPlayer], &otherFinished);
+			synchronizeNewUnits(1 - nextPlayer, otherFinished);
 		}
 		if (framesToForward > 0)
 		{
@@ -366,10 +375,14 @@ void HLState::applyAndForward(int depth, int frames, const std::array<HLMove, 2>
 	//make sure both states are at the same frame
 	int frameDiff = _state[0].getCurrentFrame() - _state[1].getCurrentFrame();
 	if (frameDiff < 0){
-		synchronizeNewUnits(0, _state[0].fastForward(_state[1].getCurrentFrame()));
+		BOSS::FinishedActions finished;
+		_state[0].fastForward(_state[1].getCurrentFrame(), &finished);
+		synchronizeNewUnits(0, finished);
 	}
 	else if (frameDiff > 0){
-		synchronizeNewUnits(1, _state[1].fastForward(_state[0].getCurrentFrame()));
+		BOSS::FinishedActions finished;
+		_state[1].fastForward(_state[0].getCurrentFrame(), &finished);
+		synchronizeNewUnits(1, finished);
 	}
 	if (std::abs(frameDiff) > 0)
 	{
@@ -387,9 +400,10 @@ void HLState::applyAndForward(int depth, int frames, const std::array<HLMove, 2>
 //		}
 //	}
 //}
-void HLState::synchronizeNewUnits(int playerID, const std::vector<BOSS::ActionType> &finishedUnits)
+void HLState::synchronizeNewUnits(int playerID, const BOSS::FinishedActions &finishedUnits)
 {
-	for (auto &unit : finishedUnits){
+	for (size_t u = 0; u < finishedUnits.size(); u++){
+		const BOSS::ActionType &unit = finishedUnits[u];
 		if (unit.isUnit()){
 			if ((_unitData[playerID].getNumUnits(unit.getUnitType()) ==
 				_unitData[playerID].getNumCompletedUnits(unit.getUnitType())) ||
@@ -426,7 +440,7 @@ void HLState::synchronizeNewUnits(int playerID, const std::vector<BOSS::ActionTy
 	}
 }
 
-void HLState::synchronizeNewUnits(int playerID, const std::vector<BOSS::ActionType> &finishedUnits, const 	BOSS::ActionType &startedUnit)
+void HLState::synchronizeNewUnits(int playerID, const BOSS::FinishedActions &finishedUnits, const 	BOSS::ActionType &startedUnit)
 {
 	if (startedUnit.isUnit()){
 		auto parentType = startedUnit.getUnitType().whatBuilds().first;
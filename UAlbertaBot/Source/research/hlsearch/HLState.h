@@ -68,8 +68,8 @@ namespace UAlbertaBot{
 		void addSquads(const BWAPI::PlayerInterface *player);
 		//static HLSquad merge(const HLSquad& s1, const HLSquad &s2);//merge s2 into s1, keeps order of s1
 		//void forwardGameState(int frames, int playerID);
-		void synchronizeNewUnits(int playerID, const std::vector<BOSS::ActionType> &newUnits);
-		void synchronizeNewUnits(int playerID, const std::vector<BOSS::ActionType> &newUnits, const BOSS::ActionType &startedUnit);
+		void synchronizeNewUnits(int playerID, const BOSS::FinishedActions &newUnits);
+		void synchronizeNewUnits(int playerID, const BOSS::FinishedActions &newUnits, const BOSS::ActionType &startedUnit);
 		void synchronizeDeadUnits(const std::array<std::vector<UnitInfo>, 2> &units);
 		BOSS::BuildOrder getBuildOrder(const HLMove &move, int playerID) const;
 		bool checkChoicePoint(const HLMove &move, int playerID) const;